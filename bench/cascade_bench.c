@@ -0,0 +1,337 @@
+#include <string.h>
+#include <time.h>
+#include "cascade.h"
+
+#ifndef CASCADE_VERSION
+#define CASCADE_VERSION "unknown"
+#endif
+
+#define NUM_RANDOM 4
+
+/* ================================= Corpus ================================= */
+
+typedef struct {
+	char name[32];
+	acb_ode_struct ODE;	/* around the origin */
+	acb_ode_struct regular;	/* around an ordinary point, for the power series solvers */
+	acb_t rho;		/* an exponent at the origin, if it is singular */
+	int singular;
+} corpus_entry;
+
+static void corpus_set_regular (corpus_entry *op, acb_srcptr a)
+{
+	acb_ode_init_blank(&op->regular, degree(&op->ODE), order(&op->ODE));
+	acb_ode_shift(&op->regular, &op->ODE, a, 1024);
+}
+
+static slong corpus_init (corpus_entry *corpus, flint_rand_t state)
+{
+	/* Legendre's equation is regular at the origin, Bessel's and Euler's equations are not */
+	slong num = 0;
+	acb_t a, b, c;
+	acb_init(a);
+	acb_init(b);
+	acb_init(c);
+
+	for (ulong n = 3; n <= 30; n *= 10, num++)
+	{
+		flint_sprintf(corpus[num].name, "legendre(%wu)", n);
+		acb_ode_legendre(&corpus[num].ODE, n);
+		acb_init(corpus[num].rho);
+		corpus[num].singular = 0;
+		acb_zero(a);
+		corpus_set_regular(corpus + num, a);
+	}
+
+	flint_sprintf(corpus[num].name, "bessel(1/3)");
+	acb_init(corpus[num].rho);
+	acb_set_si(corpus[num].rho, 1);
+	acb_div_si(corpus[num].rho, corpus[num].rho, 3, 1024);
+	acb_set(a, corpus[num].rho);
+	acb_ode_bessel(&corpus[num].ODE, a, 1024);
+	corpus[num].singular = 1;
+	acb_one(a);
+	corpus_set_regular(corpus + num, a);
+	num++;
+
+	flint_sprintf(corpus[num].name, "hypgeom(1/3,1/2,1/5)");
+	acb_set_si(a, 1);
+	acb_div_si(a, a, 3, 1024);
+	acb_set_si(b, 1);
+	acb_div_si(b, b, 2, 1024);
+	acb_set_si(c, 1);
+	acb_div_si(c, c, 5, 1024);
+	acb_ode_hypgeom(&corpus[num].ODE, a, b, c, 1024);
+	acb_init(corpus[num].rho);
+	corpus[num].singular = 1;
+	corpus_set_regular(corpus + num, b);
+	num++;
+
+	/* Random operators of different shapes, redrawn until the origin is an ordinary point */
+	for (slong k = 0; k < NUM_RANDOM; k++, num++)
+	{
+		acb_ode_random(&corpus[num].ODE, state, 53);
+		while (acb_contains_zero(acb_ode_coeff(&corpus[num].ODE, order(&corpus[num].ODE), 0)))
+		{
+			acb_ode_clear(&corpus[num].ODE);
+			acb_ode_random(&corpus[num].ODE, state, 53);
+		}
+		flint_sprintf(corpus[num].name, "random(%wd)", k);
+		acb_init(corpus[num].rho);
+		corpus[num].singular = 0;
+		acb_zero(a);
+		corpus_set_regular(corpus + num, a);
+	}
+
+	acb_clear(a);
+	acb_clear(b);
+	acb_clear(c);
+	return num;
+}
+
+static void corpus_clear (corpus_entry *corpus, slong num)
+{
+	for (slong k = 0; k < num; k++)
+	{
+		acb_ode_clear(&corpus[k].ODE);
+		acb_ode_clear(&corpus[k].regular);
+		acb_clear(corpus[k].rho);
+	}
+}
+
+/* ============================== Benchmarks ================================ */
+
+typedef struct {
+	corpus_entry *op;
+	slong prec;
+	slong terms;
+	acb_poly_t poly;
+	acb_ptr path;		/* three points within the disk of convergence */
+	acb_mat_t mono;
+	acb_ode_solution_t sol;	/* solved beforehand, for the evaluation */
+	arb_t rad;
+	acb_t x, y;
+} bench_state;
+
+static void bench_state_init (bench_state *st, corpus_entry *op, slong prec, slong terms)
+{
+	st->op = op;
+	st->prec = prec;
+	st->terms = terms;
+	acb_poly_init(st->poly);
+	st->path = _acb_vec_init(3);
+	acb_mat_init(st->mono, order(&op->ODE), order(&op->ODE));
+	arb_init(st->rad);
+	acb_init(st->x);
+	acb_init(st->y);
+
+	/* Two steps of a quarter of the radius of convergence */
+	radius_of_convergence(st->rad, &op->regular, 20, prec);
+	arb_get_mid_arb(st->rad, st->rad);
+	if (!arb_is_finite(st->rad) || arb_is_zero(st->rad))
+		arb_one(st->rad);
+	arb_mul_2exp_si(st->rad, st->rad, -2);
+	acb_set_arb(st->path + 1, st->rad);
+	acb_set_arb(st->path + 2, st->rad);
+	arb_set(acb_imagref(st->path + 2), st->rad);
+
+	acb_set_d(st->x, 0.5);
+	acb_ode_solution_init(st->sol, op->rho, 1, 0);
+	if (op->singular && terms > 0)
+		acb_ode_solve_frobenius(st->sol, &op->ODE, terms, prec);
+}
+
+static void bench_state_clear (bench_state *st)
+{
+	acb_poly_clear(st->poly);
+	_acb_vec_clear(st->path, 3);
+	acb_mat_clear(st->mono);
+	acb_ode_solution_clear(st->sol);
+	arb_clear(st->rad);
+	acb_clear(st->x);
+	acb_clear(st->y);
+}
+
+static void set_initial_values (acb_poly_t res)
+{
+	acb_poly_zero(res);
+	acb_poly_set_coeff_si(res, 0, 1);
+	acb_poly_set_coeff_si(res, 1, -1);
+}
+
+static void bench_fuchs (bench_state *st)
+{
+	set_initial_values(st->poly);
+	acb_ode_solve_fuchs(st->poly, &st->op->regular, st->terms, st->prec);
+}
+
+static void bench_frobenius (bench_state *st)
+{
+	acb_ode_solution_t sol;
+	acb_ode_solution_init(sol, st->op->rho, 1, 0);
+	acb_ode_solve_frobenius(sol, &st->op->ODE, st->terms, st->prec);
+	acb_ode_solution_clear(sol);
+}
+
+static void bench_continuation (bench_state *st)
+{
+	set_initial_values(st->poly);
+	analytic_continuation(st->poly, &st->op->regular, st->path, 3, st->terms, st->prec);
+}
+
+static void bench_monodromy (bench_state *st)
+{
+	find_monodromy_matrix(st->mono, &st->op->ODE, st->prec);
+}
+
+static void bench_radius (bench_state *st)
+{
+	radius_of_convergence(st->rad, &st->op->regular, 20, st->prec);
+}
+
+static void bench_evaluate (bench_state *st)
+{
+	acb_ode_solution_evaluate(st->y, st->sol, st->x, st->prec);
+}
+
+#define USES_TERMS	1
+#define SINGULAR	2	/* needs a regular singular point at the origin */
+
+typedef struct {
+	const char *name;
+	void (*run) (bench_state *st);
+	int flags;
+} bench_t;
+
+static const bench_t benchmarks[] = {
+	{"acb_ode_solve_fuchs", bench_fuchs, USES_TERMS},
+	{"acb_ode_solve_frobenius", bench_frobenius, USES_TERMS | SINGULAR},
+	{"analytic_continuation", bench_continuation, USES_TERMS},
+	{"find_monodromy_matrix", bench_monodromy, SINGULAR},
+	{"radius_of_convergence", bench_radius, 0},
+	{"acb_ode_solution_evaluate", bench_evaluate, USES_TERMS | SINGULAR},
+};
+
+static double wall_time (void)
+{
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec + 1e-9*t.tv_nsec;
+}
+
+static double time_benchmark (const bench_t *b, bench_state *st, double min_time, slong *repeats)
+{
+	/* Double the number of calls until the total time can be measured reliably */
+	double elapsed;
+	for (slong n = 1; ; n *= 2)
+	{
+		double start = wall_time();
+		for (slong k = 0; k < n; k++)
+			b->run(st);
+		elapsed = wall_time() - start;
+		if (elapsed >= min_time || n >= WORD(1) << 20)
+		{
+			*repeats = n;
+			return elapsed / n;
+		}
+	}
+}
+
+/* ================================== Main ================================== */
+
+static void usage (const char *name)
+{
+	flint_fprintf(stderr, "Usage: %s [--quick | --full] [--threads n] [--min-time seconds] [--output file] [function]\n", name);
+	flint_fprintf(stderr, "Times the solvers on a corpus of operators and writes the results as JSON.\n");
+}
+
+int main (int argc, char **argv)
+{
+	slong precs[] = {64, 256, 1024, 4096};
+	slong terms[] = {16, 64, 256, 1024};
+	slong num_precs = 3, num_terms = 4, num_ops, threads = 1;
+	double min_time = 0.1;
+	const char *filter = NULL;
+	FILE *out = stdout;
+	int first = 1;
+
+	flint_rand_t state;
+	corpus_entry corpus[4 + NUM_RANDOM];
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--quick") == 0)
+		{
+			num_precs = 2;
+			num_terms = 2;
+			min_time = 0.01;
+		}
+		else if (strcmp(argv[i], "--full") == 0)
+			num_precs = 4;
+		else if (strcmp(argv[i], "--threads") == 0 && i+1 < argc)
+			threads = atol(argv[++i]);
+		else if (strcmp(argv[i], "--min-time") == 0 && i+1 < argc)
+			min_time = atof(argv[++i]);
+		else if (strcmp(argv[i], "--output") == 0 && i+1 < argc)
+		{
+			out = fopen(argv[++i], "w");
+			if (out == NULL)
+			{
+				flint_fprintf(stderr, "Could not open %s for writing.\n", argv[i]);
+				return EXIT_FAILURE;
+			}
+		}
+		else if (argv[i][0] != '-' && filter == NULL)
+			filter = argv[i];
+		else
+		{
+			usage(argv[0]);
+			return EXIT_FAILURE;
+		}
+	}
+
+	flint_set_num_threads(FLINT_MAX(threads, 1));
+	flint_randinit(state);
+	num_ops = corpus_init(corpus, state);
+
+	flint_fprintf(out, "{\n\t\"version\": \"%s\",\n\t\"threads\": %wd,\n\t\"min_time\": %g,\n\t\"results\": [",
+			CASCADE_VERSION, FLINT_MAX(threads, 1), min_time);
+	for (size_t b = 0; b < sizeof(benchmarks)/sizeof(bench_t); b++)
+	{
+		if (filter != NULL && strcmp(filter, benchmarks[b].name) != 0)
+			continue;
+		for (slong k = 0; k < num_ops; k++)
+		{
+			corpus_entry *op = corpus + k;
+			if ((benchmarks[b].flags & SINGULAR) && !op->singular)
+				continue;
+			for (slong p = 0; p < num_precs; p++)
+			for (slong t = 0; t < ((benchmarks[b].flags & USES_TERMS) ? num_terms : 1); t++)
+			{
+				slong n = (benchmarks[b].flags & USES_TERMS) ? terms[t] : 0;
+				slong repeats;
+				double seconds;
+				bench_state st;
+
+				bench_state_init(&st, op, precs[p], n);
+				seconds = time_benchmark(benchmarks + b, &st, min_time, &repeats);
+				bench_state_clear(&st);
+
+				flint_fprintf(out, "%s\n\t\t{\"function\": \"%s\", \"operator\": \"%s\", \"order\": %wd, \"degree\": %wd, "
+						"\"prec\": %wd, \"terms\": %wd, \"repeats\": %wd, \"seconds\": %.6e}",
+						first ? "" : ",", benchmarks[b].name, op->name, order(&op->ODE), degree(&op->ODE),
+						precs[p], n, repeats, seconds);
+				fflush(out);
+				first = 0;
+			}
+		}
+	}
+	flint_fprintf(out, "\n\t]\n}\n");
+
+	if (out != stdout)
+		fclose(out);
+	corpus_clear(corpus, num_ops);
+	flint_randclear(state);
+	flint_cleanup();
+	return EXIT_SUCCESS;
+}
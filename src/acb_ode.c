@@ -72,7 +72,7 @@ void acb_ode_set (acb_ode_t ODE_out, acb_ode_t ODE_in)
 	if (ODE_out->alloc < ODE_in->alloc)
 	{
 		acb_ode_clear(ODE_out);
-		acb_ode_init_blank(ODE_out, order(ODE_in), degree(ODE_in));
+		acb_ode_init_blank(ODE_out, degree(ODE_in), order(ODE_in));
 	}
 	_acb_vec_set(ODE_out->polys, ODE_in->polys, ODE_in->alloc);
 	degree(ODE_out) = degree(ODE_in);
@@ -129,9 +129,12 @@ void acb_ode_shift (acb_ode_t ODE_out, acb_ode_t ODE_in, acb_srcptr a, slong bit
 		return;
 	if (degree(ODE_in) == 0)
 		return;
+	double start = acb_ode_stats_active() ? _acb_ode_stats_clock() : 0;
 	for (slong j = 0; j <= order(ODE_out); j++)
 		_acb_poly_taylor_shift(acb_ode_poly(ODE_out, j), a, degree(ODE_out)+1, bits);
 	ODE_out->valuation = UNDEFINED;
+	if (acb_ode_stats_active())
+		_acb_ode_stats_add_time(ACB_ODE_STAGE_SHIFT, start);
 }
 
 slong acb_ode_reduce (acb_ode_t ODE)
@@ -182,59 +185,149 @@ slong acb_ode_valuation (acb_ode_t ODE)
 
 /* Differential Action */
 
-void acb_ode_apply (acb_poly_t out, acb_ode_t ODE, acb_poly_t in, slong prec)
+void acb_ode_apply_trunc_ws (acb_poly_t out, acb_ode_t ODE, acb_poly_t in, slong len,
+		acb_ode_workspace_t ws, slong prec)
 {
-	acb_poly_t deriv, acc;
-	acb_poly_init(deriv);
-	acb_poly_init(acc);
+	/* Apply ODE to in modulo x^len, reading the rows of ODE in place */
+	slong dlen, rlen;
+	acb_ptr deriv, prod, res;
 
-	acb_poly_set(deriv, in);
-	acb_poly_zero(out);
-	for (slong i = 0; i <= order(ODE); i++)
+	if (len <= 0)
 	{
-		acb_poly_zero(acc);
-		for (slong j = 0; j <= degree(ODE); j++)
-			acb_poly_set_coeff_acb(acc, j, acb_ode_coeff(ODE, i, j));
+		acb_poly_zero(out);
+		return;
+	}
+
+	/* The i-th derivative modulo x^len needs len + i coefficients */
+	dlen = FLINT_MIN(acb_poly_length(in), len + order(ODE));
+	deriv = acb_ode_workspace_vec(ws, dlen + 2*len);
+	prod = deriv + dlen;
+	res = prod + len;
+
+	_acb_vec_set(deriv, in->coeffs, dlen);
+	_acb_vec_zero(res, len);
+	for (slong i = 0; i <= order(ODE) && dlen > 0; i++)
+	{
+		for (rlen = degree(ODE) + 1; rlen > 0; rlen--)
+			if (!acb_is_zero(acb_ode_coeff(ODE, i, rlen - 1)))
+				break;
+
+		if (rlen > 0)
+		{
+			/* _acb_poly_mullow needs the longer factor first */
+			slong n = FLINT_MIN(len, rlen + dlen - 1);
+			if (rlen >= dlen)
+				_acb_poly_mullow(prod, acb_ode_poly(ODE, i), rlen, deriv, dlen, n, prec);
+			else
+				_acb_poly_mullow(prod, deriv, dlen, acb_ode_poly(ODE, i), rlen, n, prec);
+			_acb_vec_add(res, res, prod, n, prec);
+		}
+
+		_acb_poly_derivative(deriv, deriv, dlen, prec);
+		dlen--;
+	}
+
+	acb_poly_fit_length(out, len);
+	_acb_vec_swap(out->coeffs, res, len);
+	_acb_poly_set_length(out, len);
+	_acb_poly_normalise(out);
+}
+
+void acb_ode_apply_trunc (acb_poly_t out, acb_ode_t ODE, acb_poly_t in, slong len, slong prec)
+{
+	acb_ode_workspace_t ws;
+	acb_ode_workspace_init(ws);
+	acb_ode_apply_trunc_ws(out, ODE, in, len, ws, prec);
+	acb_ode_workspace_clear(ws);
+}
+
+void acb_ode_apply_ws (acb_poly_t out, acb_ode_t ODE, acb_poly_t in, acb_ode_workspace_t ws, slong prec)
+{
+	acb_ode_apply_trunc_ws(out, ODE, in, acb_poly_length(in) + degree(ODE), ws, prec);
+}
+
+void acb_ode_apply (acb_poly_t out, acb_ode_t ODE, acb_poly_t in, slong prec)
+{
+	acb_ode_apply_trunc(out, ODE, in, acb_poly_length(in) + degree(ODE), prec);
+}
+
+void acb_ode_residual_ws (mag_t res, acb_ode_t ODE, acb_poly_t in, slong deg, acb_ode_workspace_t ws, slong prec)
+{
+	/* Bound the first deg coefficients of L(in) */
+	mag_t temp;
+	acb_poly_struct *out = acb_ode_workspace_polys(ws, 1);
 
-		acb_poly_mul(acc, acc, deriv, prec);
-		acb_poly_add(out, out, acc, prec);
+	mag_init(temp);
 
-		acb_poly_derivative(deriv, deriv, prec);
+	acb_ode_apply_trunc_ws(out, ODE, in, deg, ws, prec);
+	mag_zero(res);
+	for (slong i = 0; i < acb_poly_length(out); i++)
+	{
+		acb_get_mag(temp, out->coeffs + i);
+		mag_max(res, res, temp);
 	}
-	acb_poly_clear(deriv);
-	acb_poly_clear(acc);
+
+	mag_clear(temp);
+}
+
+void acb_ode_residual (mag_t res, acb_ode_t ODE, acb_poly_t in, slong deg, slong prec)
+{
+	acb_ode_workspace_t ws;
+	acb_ode_workspace_init(ws);
+	acb_ode_residual_ws(res, ODE, in, deg, ws, prec);
+	acb_ode_workspace_clear(ws);
 }
 
 int acb_ode_solves (acb_ode_t ODE, acb_poly_t res, slong deg, slong prec)
 {
+	/* Check that the first deg coefficients of L(res) may vanish */
 	int solved = 1;
-	acb_t coeff;
 	acb_poly_t out;
 
-	acb_init(coeff);
 	acb_poly_init(out);
-	acb_poly_fit_length(out, deg);
-	acb_ode_apply(out, ODE, res, prec);
-	for (slong i = 0; i < deg; i++)
-	{
-		acb_poly_get_coeff_acb(coeff, out, i);
-		if (!acb_is_finite(coeff))
-		{
-			flint_printf("Coefficient %w/%w is infinite.\n", i, deg);
-			solved = 0;
-			break;
-		}
-		else if (!acb_contains_zero(coeff))
-		{
-			flint_printf("Coefficient %w/%w is non-zero.\n", i, deg);
-			acb_printd(coeff, 20);
-			flint_printf("\nPrecision %w.\n", prec);
-			solved = 0;
-			break;
-		}
-	}
+	acb_ode_apply_trunc(out, ODE, res, deg, prec);
+	for (slong i = 0; i < acb_poly_length(out) && solved; i++)
+		solved = acb_is_finite(out->coeffs + i) && acb_contains_zero(out->coeffs + i);
 
 	acb_poly_clear(out);
-	acb_clear(coeff);
 	return solved;
 }
+
+/* Operator families */
+
+void acb_ode_family_init (acb_ode_family_t F, slong length, slong degree, slong order)
+{
+	F->length = length;
+	F->ops = flint_malloc(length * sizeof(acb_ode_struct));
+	for (slong k = 0; k < length; k++)
+		acb_ode_init_blank(F->ops + k, degree, order);
+}
+
+void acb_ode_family_clear (acb_ode_family_t F)
+{
+	for (slong k = 0; k < F->length; k++)
+		acb_ode_clear(F->ops + k);
+	flint_free(F->ops);
+}
+
+void acb_ode_family_shift (acb_ode_family_t F_out, acb_ode_family_t F_in, acb_srcptr a, slong bits)
+{
+	/* The shift is linear, so it acts on every operator separately */
+	for (slong k = 0; k < F_in->length; k++)
+		acb_ode_shift(F_out->ops + k, F_in->ops + k, a, bits);
+}
+
+void acb_ode_family_get (acb_ode_t ODE, acb_ode_family_t F, const acb_t e, slong bits)
+{
+	/* Horner's scheme in e, all operators have the same shape */
+	slong size;
+
+	acb_ode_set(ODE, F->ops + F->length - 1);
+	size = (order(ODE) + 1)*(degree(ODE) + 1);
+	for (slong k = F->length - 2; k >= 0; k--)
+	{
+		_acb_vec_scalar_mul(ODE->polys, ODE->polys, size, e, bits);
+		_acb_vec_add(ODE->polys, ODE->polys, F->ops[k].polys, size, bits);
+	}
+	ODE->valuation = UNDEFINED;
+}
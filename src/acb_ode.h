@@ -30,6 +30,11 @@ void	acb_ode_random (acb_ode_t ode, flint_rand_t state, slong prec);
 
 /* I/O */
 void	acb_ode_dump (acb_ode_t ODE, char *file);
+#define ACB_ODE_PARSE_MAX_DEGREE	4096	/* largest degree and exponent of z accepted by the parser */
+#define ACB_ODE_PARSE_MAX_ORDER		256
+
+int	acb_ode_parse (acb_ode_t ODE, const char *str, slong prec);
+int	acb_ode_parse_file (acb_ode_t ODE, FILE *in, slong prec);
 
 /* Transformations */
 void	acb_ode_shift (acb_ode_t ODE_out, acb_ode_t ODE_in, acb_srcptr a, slong bits);
@@ -37,9 +42,158 @@ slong	acb_ode_reduce (acb_ode_t ODE);
 slong	acb_ode_valuation (acb_ode_t ODE);
 
 /* Differential Action */
+void	acb_ode_apply_trunc (acb_poly_t out, acb_ode_t ODE, acb_poly_t in, slong len, slong prec);
 void	acb_ode_apply (acb_poly_t out, acb_ode_t ODE, acb_poly_t in, slong prec);
+void	acb_ode_residual (mag_t res, acb_ode_t ODE, acb_poly_t in, slong deg, slong prec);
 int	acb_ode_solves (acb_ode_t ODE, acb_poly_t res, slong deg, slong prec);
 
+/* ============================ Operator Families =========================== */
+
+typedef struct {
+	acb_ode_struct *ops;	/* the operator ops[0] + e ops[1] + ... + e^(length-1) ops[length-1] */
+	slong length;
+} acb_ode_family_struct;
+
+typedef acb_ode_family_struct acb_ode_family_t[1];
+
+void	acb_ode_family_init (acb_ode_family_t F, slong length, slong degree, slong order);
+void	acb_ode_family_clear (acb_ode_family_t F);
+
+void	acb_ode_family_shift (acb_ode_family_t F_out, acb_ode_family_t F_in, acb_srcptr a, slong bits);
+void	acb_ode_family_get (acb_ode_t ODE, acb_ode_family_t F, const acb_t e, slong bits);
+
+/* ============================ Shifted Operators =========================== */
+
+typedef struct {
+	acb_ode_struct *base;	/* not owned by the cache */
+	acb_ptr points;
+	acb_ode_struct **shifts;	/* base shifted to points[k] */
+	slong length;
+	slong alloc;
+	slong bits;
+} acb_ode_shift_cache_struct;
+
+typedef acb_ode_shift_cache_struct acb_ode_shift_cache_t[1];
+
+void	acb_ode_shift_cache_init (acb_ode_shift_cache_t cache, acb_ode_t ODE, slong bits);
+void	acb_ode_shift_cache_clear (acb_ode_shift_cache_t cache);
+
+acb_ode_struct *	acb_ode_shift_cache_get (acb_ode_shift_cache_t cache, acb_srcptr a);
+
+/* =============================== Recurrences ============================== */
+
+typedef struct {
+	slong order;
+	slong valuation;
+	slong length;		/* number of diagonals */
+	slong alloc;		/* number of allocated entries */
+	slong *top;		/* largest i with a non-zero entry on each diagonal */
+	acb_ptr diags;		/* diagonal d holds c_{i,i+v+d} for 0 <= i <= order */
+} acb_ode_plan_struct;
+
+typedef acb_ode_plan_struct acb_ode_plan_t[1];
+
+#define acb_ode_plan_entry(P, d, i) ((P)->diags + (d)*((P)->order+1) + (i))
+
+void	acb_ode_plan_init (acb_ode_plan_t plan, acb_ode_t ODE);
+void	acb_ode_plan_clear (acb_ode_plan_t plan);
+void	acb_ode_plan_set (acb_ode_plan_t plan, acb_ode_t ODE);
+
+void	acb_ode_plan_evaluate (acb_t res, acb_ode_plan_t plan, slong d, slong b, slong prec);
+
+/* =============================== Workspaces =============================== */
+
+typedef struct {
+	acb_ptr vec;		/* scratch balls */
+	slong vec_alloc;
+	acb_poly_struct *polys;	/* scratch polynomials */
+	slong polys_alloc;
+	acb_ode_struct ODE;	/* scratch operator, e.g. a shifted copy */
+	acb_ode_plan_struct plan;	/* recurrence of the operator being solved */
+} acb_ode_workspace_struct;
+
+typedef acb_ode_workspace_struct acb_ode_workspace_t[1];
+
+void	acb_ode_workspace_init (acb_ode_workspace_t ws);
+void	acb_ode_workspace_clear (acb_ode_workspace_t ws);
+
+acb_ptr	acb_ode_workspace_vec (acb_ode_workspace_t ws, slong len);
+acb_poly_struct *	acb_ode_workspace_polys (acb_ode_workspace_t ws, slong num);
+
+void	acb_ode_apply_trunc_ws (acb_poly_t out, acb_ode_t ODE, acb_poly_t in, slong len,
+		acb_ode_workspace_t ws, slong prec);
+void	acb_ode_apply_ws (acb_poly_t out, acb_ode_t ODE, acb_poly_t in, acb_ode_workspace_t ws, slong prec);
+void	acb_ode_residual_ws (mag_t res, acb_ode_t ODE, acb_poly_t in, slong deg, acb_ode_workspace_t ws, slong prec);
+
+/* Tail bounds from the recurrence */
+typedef struct {
+	slong order;
+	slong length;		/* number of diagonals of the recurrence */
+	slong degree;		/* degree of P_0 */
+	slong M;		/* number of generators, i.e. power series in log */
+	mag_ptr bounds;		/* coefficients in n of |P_d(n-d+rho+e)| for d >= 1 */
+	mag_t lead;		/* lower bound for the leading coefficient of P_0 */
+	mag_t shift;		/* P_0(n+rho+e) is invertible for n > shift */
+} acb_ode_tail_struct;
+
+typedef acb_ode_tail_struct acb_ode_tail_t[1];
+
+#define acb_ode_tail_entry(T, d, j) ((T)->bounds + ((d)-1)*((T)->degree+1) + (j))
+
+void	acb_ode_tail_init (acb_ode_tail_t tail, acb_ode_plan_t plan, acb_srcptr rho, slong M, slong prec);
+void	acb_ode_tail_clear (acb_ode_tail_t tail);
+
+void	acb_ode_tail_norm (mag_t res, acb_ode_tail_t tail, const acb_poly_struct *gens, slong n);
+void	acb_ode_tail_bound (mag_t res, acb_ode_tail_t tail, const acb_poly_struct *gens, slong N, const mag_t eta);
+void	acb_ode_tail_bound_derivatives (mag_ptr res, acb_ode_tail_t tail, const acb_poly_struct *gens, slong N,
+		const mag_t eta, slong len);
+int	acb_ode_tail_check (mag_t err, acb_ode_tail_t tail, const acb_poly_struct *gens, slong N, const mag_t eta, slong bits);
+
+/* ============================= Instrumentation ============================ */
+
+#define ACB_ODE_STAGE_SHIFT		0
+#define ACB_ODE_STAGE_RECURRENCE	1
+#define ACB_ODE_STAGE_TAYLOR_SHIFT	2
+#define ACB_ODE_STAGE_EVALUATION	3
+#define ACB_ODE_NUM_STAGES		4
+
+#define ACB_ODE_EVENT_COEFFICIENT	0
+#define ACB_ODE_EVENT_SEGMENT		1
+
+typedef struct {
+	int kind;
+	slong index;		/* of the coefficient, or the step of the path */
+	slong terms;		/* number of coefficients used for the step */
+	slong accuracy;		/* relative accuracy in bits */
+	acb_srcptr value;	/* the coefficient, or the end point of the step */
+} acb_ode_event_struct;
+
+typedef struct {
+	double time[ACB_ODE_NUM_STAGES];	/* in seconds */
+	slong calls[ACB_ODE_NUM_STAGES];
+	slong coeffs;		/* computed by the recurrence of the power series and Frobenius solvers */
+	slong evaluations;	/* of diagonals of the recurrence, by the power series solvers */
+	slong segments;		/* steps of analytic continuation */
+	slong accuracy;		/* the lowest relative accuracy reported */
+	int per_coefficient;	/* also report every coefficient of a power series */
+	void (*callback) (const acb_ode_event_struct *event, void *data);
+	void *data;
+} acb_ode_stats_struct;
+
+typedef acb_ode_stats_struct acb_ode_stats_t[1];
+
+void	acb_ode_stats_init (acb_ode_stats_t stats);
+void	acb_ode_stats_enable (acb_ode_stats_t stats);
+void	acb_ode_stats_disable (void);
+void	acb_ode_stats_fprint (FILE *out, acb_ode_stats_t stats);
+int	acb_ode_stats_active (void);
+
+double	_acb_ode_stats_clock (void);
+void	_acb_ode_stats_add_time (int stage, double start);
+void	_acb_ode_stats_recurrence (slong coeffs, slong evaluations);
+void	_acb_ode_stats_coefficients (acb_srcptr c, slong first, slong start, slong end);
+void	_acb_ode_stats_segment (slong step, slong terms, acb_srcptr point, acb_srcptr vals, slong len);
+
 /* =============================== Solutions ================================ */
 
 typedef struct {
@@ -55,15 +209,46 @@ void	acb_ode_solution_init (acb_ode_solution_t sol, acb_t rho, slong mul, slong
 void	acb_ode_solution_clear (acb_ode_solution_t sol);
 
 void	acb_ode_solution_evaluate (acb_t res, acb_ode_solution_t sol, acb_t x, slong mu);
+void	acb_ode_solution_evaluate_vec (acb_ptr res, acb_ode_solution_t sol, acb_srcptr x, slong num, slong len, slong prec);
 
 void	_acb_ode_solution_update (acb_ode_solution_t sol, acb_poly_t f, slong prec);
 void	_acb_ode_solution_extend (acb_ode_solution_t sol, slong nu, acb_poly_t g_nu, slong prec);
+void	_acb_ode_solution_extend_series (acb_ode_solution_t sol, slong nu, acb_poly_t g_nu, slong prec);
 void	_acb_ode_solution_normalize (acb_ode_solution_t sol, slong prec);
 
+/* ============================== Binary Files ============================== */
+
+#define ACB_ODE_FILE_OPERATOR 1
+#define ACB_ODE_FILE_SOLUTION 2
+
+typedef struct {
+	const unsigned char *data;	/* the mapped file */
+	size_t size;
+	slong kind;
+	slong dims[2];		/* order and degree, or M and multiplicity */
+	slong num;		/* number of vectors */
+} acb_ode_file_struct;
+
+typedef acb_ode_file_struct acb_ode_file_t[1];
+
+int	acb_ode_write (acb_ode_t ODE, const char *file);
+int	acb_ode_read (acb_ode_t ODE, const char *file);
+int	acb_ode_solution_write (acb_ode_solution_t sol, const char *file);
+int	acb_ode_solution_read (acb_ode_solution_t sol, const char *file);
+
+int	acb_ode_file_open (acb_ode_file_t f, const char *file);
+void	acb_ode_file_close (acb_ode_file_t f);
+slong	acb_ode_file_length (const acb_ode_file_t f, slong k);
+void	_acb_ode_file_get (acb_ptr res, const acb_ode_file_t f, slong k, slong start, slong len);
+void	acb_ode_file_get (acb_t res, const acb_ode_file_t f, slong k, slong n);
+
 /* ================================ Examples ================================ */
 
 void	acb_ode_legendre (acb_ode_t ODE, ulong n);
 void	acb_ode_bessel (acb_ode_t ODE, acb_t nu, slong bits);
 void	acb_ode_hypgeom (acb_ode_t ODE, acb_t a, acb_t b, acb_t c, slong bits);
+void	acb_ode_hypgeom_fmpq (acb_ode_t ODE, const fmpq_t a, const fmpq_t b, const fmpq_t c);
+void	acb_ode_family_bessel (acb_ode_family_t F, const acb_t nu, slong bits);
+void	acb_ode_family_hypgeom (acb_ode_family_t F, const acb_t a, const acb_t b, const acb_t c, acb_srcptr dir, slong bits);
 
 #endif
@@ -0,0 +1,400 @@
+#include <stdint.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "acb_ode.h"
+
+/* File layout: header, vector table, four arf records per ball, limbs of all mantissas.
+ * Every part is a multiple of eight bytes long, so that the file can be mapped directly */
+
+#define IO_MAGIC "CASCADE"
+#define IO_VERSION 1
+#define IO_ENDIAN 0x01020304
+
+/* Kinds of arf records */
+#define IO_ZERO 0
+#define IO_POS 1
+#define IO_NEG 2
+#define IO_POS_INF 3
+#define IO_NEG_INF 4
+#define IO_NAN 5
+
+typedef struct {
+	char magic[8];
+	uint32_t version;
+	uint32_t endian;
+	uint32_t limb_bits;
+	uint32_t kind;
+	int64_t dims[2];
+	int64_t num;		/* number of vectors */
+	int64_t balls;		/* total number of balls */
+	int64_t limbs;		/* total number of limbs */
+} io_header;
+
+typedef struct {
+	int64_t length;
+	int64_t start;		/* index of the first ball */
+} io_vector;
+
+typedef struct {
+	int32_t flag;
+	int32_t size;		/* number of limbs of the mantissa */
+	int64_t exp;
+	int64_t offset;		/* index of the first limb */
+} io_arf;
+
+/* Writing */
+
+typedef struct {
+	FILE *out;
+	ulong *limbs;
+	slong length;
+	slong alloc;
+	fmpz_t m;
+	fmpz_t e;
+} io_writer;
+
+static int io_put_arf (io_writer *w, const arf_t x)
+{
+	/* Write x as m 2^e, and append the limbs of |m| */
+	io_arf r;
+	memset(&r, 0, sizeof(io_arf));
+
+	if (arf_is_zero(x))
+		r.flag = IO_ZERO;
+	else if (arf_is_pos_inf(x))
+		r.flag = IO_POS_INF;
+	else if (arf_is_neg_inf(x))
+		r.flag = IO_NEG_INF;
+	else if (arf_is_nan(x))
+		r.flag = IO_NAN;
+	else
+	{
+		arf_get_fmpz_2exp(w->m, w->e, x);
+		if (!fmpz_fits_si(w->e))
+			return 0;
+		r.flag = (fmpz_sgn(w->m) < 0) ? IO_NEG : IO_POS;
+		fmpz_abs(w->m, w->m);
+		r.size = fmpz_size(w->m);
+		r.exp = fmpz_get_si(w->e);
+		r.offset = w->length;
+
+		if (w->length + r.size > w->alloc)
+		{
+			w->alloc = FLINT_MAX(w->length + r.size, 2*w->alloc);
+			w->limbs = flint_realloc(w->limbs, w->alloc * sizeof(ulong));
+		}
+		fmpz_get_ui_array(w->limbs + w->length, r.size, w->m);
+		w->length += r.size;
+	}
+	return fwrite(&r, sizeof(io_arf), 1, w->out) == 1;
+}
+
+static int io_put_arb (io_writer *w, const arb_t x, arf_t t)
+{
+	arf_set_mag(t, arb_radref(x));
+	return io_put_arf(w, arb_midref(x)) && io_put_arf(w, t);
+}
+
+static int io_write (const char *name, uint32_t kind, const slong *dims, acb_srcptr *vecs, const slong *lens, slong num)
+{
+	int success = 1;
+	io_header h;
+	io_vector v;
+	io_writer w;
+	arf_t t;
+
+	w.out = fopen(name, "wb");
+	if (w.out == NULL)
+		return 0;
+	w.limbs = NULL;
+	w.length = 0;
+	w.alloc = 0;
+	fmpz_init(w.m);
+	fmpz_init(w.e);
+	arf_init(t);
+
+	memset(&h, 0, sizeof(io_header));
+	memcpy(h.magic, IO_MAGIC, sizeof(IO_MAGIC));
+	h.version = IO_VERSION;
+	h.endian = IO_ENDIAN;
+	h.limb_bits = FLINT_BITS;
+	h.kind = kind;
+	h.dims[0] = dims[0];
+	h.dims[1] = dims[1];
+	h.num = num;
+	for (slong k = 0; k < num; k++)
+		h.balls += lens[k];
+
+	/* The number of limbs is only known at the end, so the header is written twice */
+	success = fwrite(&h, sizeof(io_header), 1, w.out) == 1;
+	v.start = 0;
+	for (slong k = 0; k < num && success; k++)
+	{
+		v.length = lens[k];
+		success = fwrite(&v, sizeof(io_vector), 1, w.out) == 1;
+		v.start += lens[k];
+	}
+	for (slong k = 0; k < num && success; k++)
+	{
+		for (slong n = 0; n < lens[k] && success; n++)
+			success = io_put_arb(&w, acb_realref(vecs[k] + n), t) && io_put_arb(&w, acb_imagref(vecs[k] + n), t);
+	}
+
+	if (success && w.length > 0)
+		success = fwrite(w.limbs, sizeof(ulong), w.length, w.out) == (size_t) w.length;
+	if (success)
+	{
+		h.limbs = w.length;
+		success = fseek(w.out, 0, SEEK_SET) == 0 && fwrite(&h, sizeof(io_header), 1, w.out) == 1;
+	}
+	success = (fclose(w.out) == 0) && success;
+
+	flint_free(w.limbs);
+	fmpz_clear(w.m);
+	fmpz_clear(w.e);
+	arf_clear(t);
+	return success;
+}
+
+int acb_ode_write (acb_ode_t ODE, const char *file)
+{
+	slong dims[2] = {order(ODE), degree(ODE)};
+	slong len = (ODE->polys && order(ODE) > 0 && degree(ODE) >= 0) ? (order(ODE) + 1) * (degree(ODE) + 1) : 0;
+	acb_srcptr vec = ODE->polys;
+	return io_write(file, ACB_ODE_FILE_OPERATOR, dims, &vec, &len, 1);
+}
+
+int acb_ode_solution_write (acb_ode_solution_t sol, const char *file)
+{
+	/* The exponent is stored as a vector of length one, followed by the generators */
+	int success;
+	slong dims[2] = {sol->M, sol->mul};
+	acb_srcptr *vecs = flint_malloc((sol->M + 1) * sizeof(acb_srcptr));
+	slong *lens = flint_malloc((sol->M + 1) * sizeof(slong));
+
+	vecs[0] = sol->rho;
+	lens[0] = 1;
+	for (slong i = 0; i < sol->M; i++)
+	{
+		vecs[i + 1] = sol->gens[i].coeffs;
+		lens[i + 1] = acb_poly_length(sol->gens + i);
+	}
+	success = io_write(file, ACB_ODE_FILE_SOLUTION, dims, vecs, lens, sol->M + 1);
+
+	flint_free(vecs);
+	flint_free(lens);
+	return success;
+}
+
+/* Mapped files */
+
+static const io_header * io_head (const acb_ode_file_t f)
+{
+	return (const io_header *) f->data;
+}
+
+static const io_vector * io_vectors (const acb_ode_file_t f)
+{
+	return (const io_vector *) (f->data + sizeof(io_header));
+}
+
+static const io_arf * io_arfs (const acb_ode_file_t f)
+{
+	return (const io_arf *) (f->data + sizeof(io_header) + f->num * sizeof(io_vector));
+}
+
+static const ulong * io_limbs (const acb_ode_file_t f)
+{
+	return (const ulong *) (io_arfs(f) + 4 * io_head(f)->balls);
+}
+
+int acb_ode_file_open (acb_ode_file_t f, const char *file)
+{
+	/* Map the file and check that all parts fit into it */
+	int fd;
+	struct stat st;
+	const io_header *h;
+	size_t need;
+
+	f->data = NULL;
+	f->size = 0;
+	f->num = 0;
+
+	fd = open(file, O_RDONLY);
+	if (fd < 0)
+		return 0;
+	if (fstat(fd, &st) != 0 || (size_t) st.st_size < sizeof(io_header))
+	{
+		close(fd);
+		return 0;
+	}
+	f->size = st.st_size;
+	f->data = mmap(NULL, f->size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (f->data == MAP_FAILED)
+	{
+		f->data = NULL;
+		return 0;
+	}
+
+	h = io_head(f);
+	int valid = memcmp(h->magic, IO_MAGIC, sizeof(IO_MAGIC)) == 0 && h->version == IO_VERSION
+		&& h->endian == IO_ENDIAN && h->limb_bits == FLINT_BITS
+		&& h->num >= 0 && h->balls >= 0 && h->limbs >= 0
+		&& (uint64_t) h->num <= f->size / sizeof(io_vector)
+		&& (uint64_t) h->balls <= f->size / (4 * sizeof(io_arf))
+		&& (uint64_t) h->limbs <= f->size / sizeof(ulong);
+	if (valid)
+	{
+		need = sizeof(io_header) + h->num * sizeof(io_vector) + 4 * h->balls * sizeof(io_arf) + h->limbs * sizeof(ulong);
+		valid = need <= f->size;
+	}
+	f->num = valid ? h->num : 0;
+	for (slong k = 0; k < f->num && valid; k++)
+	{
+		const io_vector *v = io_vectors(f) + k;
+		valid = v->length >= 0 && v->start >= 0 && v->start <= h->balls - v->length;
+	}
+
+	if (!valid)
+	{
+		acb_ode_file_close(f);
+		return 0;
+	}
+	f->kind = h->kind;
+	f->dims[0] = h->dims[0];
+	f->dims[1] = h->dims[1];
+	return 1;
+}
+
+void acb_ode_file_close (acb_ode_file_t f)
+{
+	if (f->data != NULL)
+		munmap((void *) f->data, f->size);
+	f->data = NULL;
+	f->size = 0;
+	f->num = 0;
+}
+
+slong acb_ode_file_length (const acb_ode_file_t f, slong k)
+{
+	if (k < 0 || k >= f->num)
+		return 0;
+	return io_vectors(f)[k].length;
+}
+
+static void io_get_arf (arf_t x, const acb_ode_file_t f, const io_arf *r, fmpz_t m, fmpz_t e)
+{
+	if (r->flag == IO_ZERO)
+		arf_zero(x);
+	else if (r->flag == IO_POS_INF)
+		arf_pos_inf(x);
+	else if (r->flag == IO_NEG_INF)
+		arf_neg_inf(x);
+	else if ((r->flag != IO_POS && r->flag != IO_NEG) || r->size <= 0
+			|| r->offset < 0 || r->offset > io_head(f)->limbs - r->size)
+		arf_nan(x);
+	else
+	{
+		fmpz_set_ui_array(m, io_limbs(f) + r->offset, r->size);
+		if (r->flag == IO_NEG)
+			fmpz_neg(m, m);
+		fmpz_set_si(e, r->exp);
+		arf_set_fmpz_2exp(x, m, e);
+	}
+}
+
+static void io_get_arb (arb_t x, const acb_ode_file_t f, const io_arf *r, fmpz_t m, fmpz_t e, arf_t t)
+{
+	io_get_arf(arb_midref(x), f, r, m, e);
+	io_get_arf(t, f, r + 1, m, e);
+	if (arf_is_nan(t) || arf_sgn(t) < 0)
+		mag_inf(arb_radref(x));
+	else
+		arf_get_mag(arb_radref(x), t);
+}
+
+void _acb_ode_file_get (acb_ptr res, const acb_ode_file_t f, slong k, slong start, slong len)
+{
+	/* Read the balls start, ..., start + len - 1 of the k-th vector, which must exist */
+	fmpz_t m, e;
+	arf_t t;
+	const io_arf *r = io_arfs(f) + 4 * (io_vectors(f)[k].start + start);
+
+	fmpz_init(m);
+	fmpz_init(e);
+	arf_init(t);
+	for (slong n = 0; n < len; n++, r += 4)
+	{
+		io_get_arb(acb_realref(res + n), f, r, m, e, t);
+		io_get_arb(acb_imagref(res + n), f, r + 2, m, e, t);
+	}
+	fmpz_clear(m);
+	fmpz_clear(e);
+	arf_clear(t);
+}
+
+void acb_ode_file_get (acb_t res, const acb_ode_file_t f, slong k, slong n)
+{
+	if (n < 0 || n >= acb_ode_file_length(f, k))
+		acb_zero(res);
+	else
+		_acb_ode_file_get(res, f, k, n, 1);
+}
+
+/* Reading */
+
+int acb_ode_read (acb_ode_t ODE, const char *file)
+{
+	acb_ode_file_t f;
+	if (!acb_ode_file_open(f, file))
+		return 0;
+
+	/* Operators of degree -1 or order 0 have no coefficients. Otherwise the length
+	 * is divided by the order, since the product of the dimensions may overflow */
+	slong len = acb_ode_file_length(f, 0);
+	int valid = f->kind == ACB_ODE_FILE_OPERATOR && f->num == 1 && f->dims[0] >= 0 && f->dims[1] >= -1;
+	if (valid && f->dims[0] > 0 && f->dims[1] >= 0)
+		valid = f->dims[0] < len && len % (f->dims[0] + 1) == 0 && len / (f->dims[0] + 1) - 1 == f->dims[1];
+	else if (valid)
+		valid = len == 0;
+	if (valid)
+	{
+		acb_ode_init_blank(ODE, f->dims[1], f->dims[0]);
+		if (len > 0)
+			_acb_ode_file_get(ODE->polys, f, 0, 0, len);
+	}
+	acb_ode_file_close(f);
+	return valid;
+}
+
+int acb_ode_solution_read (acb_ode_solution_t sol, const char *file)
+{
+	acb_t rho;
+	acb_ode_file_t f;
+	if (!acb_ode_file_open(f, file))
+		return 0;
+
+	int valid = f->kind == ACB_ODE_FILE_SOLUTION && f->dims[0] > 0 && f->dims[1] > 0 && f->dims[1] <= f->dims[0]
+		&& f->num - 1 == f->dims[0] && acb_ode_file_length(f, 0) == 1;
+	if (valid)
+	{
+		acb_init(rho);
+		acb_ode_file_get(rho, f, 0, 0);
+		acb_ode_solution_init(sol, rho, f->dims[1], f->dims[0] - f->dims[1]);
+		for (slong i = 0; i < sol->M; i++)
+		{
+			slong len = acb_ode_file_length(f, i + 1);
+			acb_poly_fit_length(sol->gens + i, len);
+			_acb_ode_file_get(sol->gens[i].coeffs, f, i + 1, 0, len);
+			_acb_poly_set_length(sol->gens + i, len);
+			_acb_poly_normalise(sol->gens + i);
+		}
+		acb_clear(rho);
+	}
+	acb_ode_file_close(f);
+	return valid;
+}
@@ -0,0 +1,426 @@
+#include <ctype.h>
+#include <string.h>
+#include "acb_ode.h"
+
+/* Operators are read as
+ *	sum  := ['+'|'-'] term (('+'|'-') term)*
+ *	term := factor (['*'] factor)*
+ *	factor := number | '[' ball ']' | 'I' | 'z' ['^' n] | 'D' ['^' n] | '(' sum ')' ['^' n]
+ * where all factors in z come before the factors D, or as rows of coefficients
+ *	'{' c_00 ',' c_01 ... ';' c_10 ... '}'
+ * Every operator is terminated by ';' or by the end of the input, and '#' starts a comment */
+
+typedef struct {
+	FILE *in;
+	const char *str;
+	int c;			/* current character, or EOF */
+	char *buf;		/* current number */
+	slong len;
+	slong alloc;
+	int rows;		/* inside the braces of the rows form */
+	acb_ode_struct *ODE;	/* coefficients so far, the order and degree are capacities */
+	slong order;
+	slong degree;
+	slong prec;
+} parser;
+
+/* Characters */
+
+static void advance (parser *p)
+{
+	if (p->in != NULL)
+		p->c = getc(p->in);
+	else
+		p->c = (*p->str != '\0') ? (unsigned char) *p->str++ : EOF;
+}
+
+static void skip_space (parser *p)
+{
+	while (isspace(p->c) || p->c == '#')
+	{
+		if (p->c == '#')
+			while (p->c != '\n' && p->c != EOF)
+				advance(p);
+		else
+			advance(p);
+	}
+}
+
+static int accept (parser *p, int c)
+{
+	skip_space(p);
+	if (p->c != c)
+		return 0;
+	advance(p);
+	return 1;
+}
+
+static void push (parser *p, int c)
+{
+	if (p->len + 2 > p->alloc)
+	{
+		p->alloc = FLINT_MAX(16, 2*p->alloc);
+		p->buf = flint_realloc(p->buf, p->alloc);
+	}
+	p->buf[p->len++] = c;
+	p->buf[p->len] = '\0';
+}
+
+/* Dense storage */
+
+static int add_coeff (parser *p, slong i, slong j, acb_srcptr c)
+{
+	/* Add c to the coefficient of z^j D^i, growing the storage geometrically up to the limits */
+	acb_ode_struct *ODE = p->ODE;
+	if (i > ACB_ODE_PARSE_MAX_ORDER || j > ACB_ODE_PARSE_MAX_DEGREE)
+		return 0;
+	if (i > order(ODE) || j > degree(ODE))
+	{
+		acb_ode_t grown;
+		acb_ode_init_blank(grown, FLINT_MAX(j, FLINT_MIN(2*degree(ODE), ACB_ODE_PARSE_MAX_DEGREE)),
+				FLINT_MAX(i, FLINT_MIN(2*order(ODE), ACB_ODE_PARSE_MAX_ORDER)));
+		for (slong k = 0; k <= p->order; k++)
+			for (slong l = 0; l <= p->degree; l++)
+				acb_swap(acb_ode_coeff(grown, k, l), acb_ode_coeff(ODE, k, l));
+		acb_ode_clear(ODE);
+		*ODE = *grown;
+	}
+	p->order = FLINT_MAX(p->order, i);
+	p->degree = FLINT_MAX(p->degree, j);
+	acb_add(acb_ode_coeff(ODE, i, j), acb_ode_coeff(ODE, i, j), c, p->prec);
+	return 1;
+}
+
+static void finish (parser *p)
+{
+	/* Reduce the row length to the actual degree; every entry moves to a lower index */
+	acb_ode_struct *ODE = p->ODE;
+	slong stride = degree(ODE) + 1;
+	for (slong i = 0; i <= p->order; i++)
+		for (slong j = 0; j <= p->degree; j++)
+			acb_swap(ODE->polys + i*(p->degree + 1) + j, ODE->polys + i*stride + j);
+	_acb_vec_zero(ODE->polys + (p->order + 1)*(p->degree + 1), ODE->alloc - (p->order + 1)*(p->degree + 1));
+	order(ODE) = p->order;
+	degree(ODE) = p->degree;
+}
+
+/* Grammar */
+
+static int parse_sum (parser *p, acb_poly_t res, int top);
+
+static int parse_exponent (parser *p, ulong *e, ulong max)
+{
+	/* Exponents above max are rejected */
+	*e = 1;
+	if (!accept(p, '^'))
+		return 1;
+	skip_space(p);
+	if (!isdigit(p->c))
+		return 0;
+	for (*e = 0; isdigit(p->c) && *e <= max; advance(p))
+		*e = 10*(*e) + (p->c - '0');
+	return *e <= max;
+}
+
+static int parse_number (parser *p, arb_t x)
+{
+	/* Integers and rationals are read exactly, decimals and balls with precision prec */
+	int exact = 1, rational = 0, ok;
+	p->len = 0;
+	if (p->c == '[')
+	{
+		for (; p->c != ']' && p->c != EOF; advance(p))
+			push(p, p->c);
+		if (p->c != ']')
+			return 0;
+		push(p, ']');
+		advance(p);
+		return arb_set_str(x, p->buf, p->prec) == 0;
+	}
+
+	while (isdigit(p->c) || p->c == '.' || p->c == 'e' || p->c == 'E' || p->c == '/')
+	{
+		exact &= (p->c != '.' && p->c != 'e' && p->c != 'E');
+		rational |= (p->c == '/');
+		push(p, p->c);
+		advance(p);
+		if ((p->buf[p->len - 1] == 'e' || p->buf[p->len - 1] == 'E') && (p->c == '+' || p->c == '-'))
+		{
+			push(p, p->c);
+			advance(p);
+		}
+	}
+
+	if (!exact)
+		ok = !rational && arb_set_str(x, p->buf, p->prec) == 0;
+	else if (rational)
+	{
+		/* Check the denominator before fmpq sees it */
+		char *slash = strchr(p->buf, '/');
+		fmpz_t a, b;
+		fmpq_t q;
+		fmpz_init(a);
+		fmpz_init(b);
+		fmpq_init(q);
+		*slash = '\0';
+		ok = fmpz_set_str(a, p->buf, 10) == 0 && fmpz_set_str(b, slash + 1, 10) == 0 && !fmpz_is_zero(b);
+		if (ok)
+		{
+			fmpq_set_fmpz_frac(q, a, b);
+			arb_set_fmpq(x, q, p->prec);
+		}
+		fmpz_clear(a);
+		fmpz_clear(b);
+		fmpq_clear(q);
+	}
+	else
+	{
+		fmpz_t n;
+		fmpz_init(n);
+		ok = fmpz_set_str(n, p->buf, 10) == 0;
+		arb_set_fmpz(x, n);
+		fmpz_clear(n);
+	}
+	return ok;
+}
+
+static int parse_factor (parser *p, acb_poly_t term, ulong *dpow, int top)
+{
+	/* Multiply term by the next factor, or increase dpow for factors D */
+	int ok = 1;
+	ulong e = 1;
+	acb_t c;
+	acb_poly_t sum;
+
+	skip_space(p);
+	if (isdigit(p->c) || p->c == '.' || p->c == '[')
+	{
+		acb_init(c);
+		ok = parse_number(p, acb_realref(c));
+		acb_poly_scalar_mul(term, term, c, p->prec);
+		acb_clear(c);
+	}
+	else if (p->c == 'I')
+	{
+		advance(p);
+		acb_init(c);
+		acb_onei(c);
+		acb_poly_scalar_mul(term, term, c, p->prec);
+		acb_clear(c);
+	}
+	else if (p->c == 'z')
+	{
+		advance(p);
+		ok = *dpow == 0 && parse_exponent(p, &e, ACB_ODE_PARSE_MAX_DEGREE)
+			&& acb_poly_degree(term) + (slong) e <= ACB_ODE_PARSE_MAX_DEGREE;
+		if (ok)
+			acb_poly_shift_left(term, term, e);
+	}
+	else if (p->c == 'D')
+	{
+		advance(p);
+		ok = top && parse_exponent(p, &e, ACB_ODE_PARSE_MAX_ORDER) && *dpow + e <= ACB_ODE_PARSE_MAX_ORDER;
+		if (ok)
+			*dpow += e;
+	}
+	else if (p->c == '(')
+	{
+		advance(p);
+		acb_poly_init(sum);
+		ok = *dpow == 0 && parse_sum(p, sum, 0) && accept(p, ')')
+			&& parse_exponent(p, &e, ACB_ODE_PARSE_MAX_DEGREE)
+			&& acb_poly_degree(term) + (slong) e * FLINT_MAX(acb_poly_degree(sum), 0) <= ACB_ODE_PARSE_MAX_DEGREE;
+		if (ok)
+		{
+			acb_poly_pow_ui(sum, sum, e, p->prec);
+			acb_poly_mul(term, term, sum, p->prec);
+		}
+		acb_poly_clear(sum);
+	}
+	else
+		ok = 0;
+	return ok;
+}
+
+static int starts_factor (int c)
+{
+	return isdigit(c) || c == '.' || c == '[' || c == '(' || c == 'I' || c == 'z' || c == 'D';
+}
+
+static int parse_sum (parser *p, acb_poly_t res, int top)
+{
+	/* At the top level, every term is added to the operator, otherwise to res */
+	int ok = 1, sign;
+	ulong dpow;
+	acb_poly_t term;
+	acb_poly_init(term);
+
+	acb_poly_zero(res);
+	sign = accept(p, '-') ? -1 : (accept(p, '+'), 1);
+	while (ok)
+	{
+		dpow = 0;
+		acb_poly_one(term);
+		if (sign < 0)
+			acb_poly_neg(term, term);
+
+		ok = parse_factor(p, term, &dpow, top);
+		while (ok)
+		{
+			skip_space(p);
+			if (accept(p, '*'))
+				ok = parse_factor(p, term, &dpow, top);
+			else if (starts_factor(p->c))
+				ok = parse_factor(p, term, &dpow, top);
+			else
+				break;
+		}
+
+		if (ok && top)
+			for (slong j = 0; j < acb_poly_length(term) && ok; j++)
+				ok = add_coeff(p, dpow, j, term->coeffs + j);
+		else if (ok)
+			acb_poly_add(res, res, term, p->prec);
+
+		if (accept(p, '+'))
+			sign = 1;
+		else if (accept(p, '-'))
+			sign = -1;
+		else
+			break;
+	}
+
+	acb_poly_clear(term);
+	return ok;
+}
+
+static int parse_rows (parser *p)
+{
+	/* Row i holds the coefficients of z^0, z^1, ... in front of D^i */
+	int ok = 1;
+	slong i = 0, j = 0;
+	acb_poly_t c;
+	acb_poly_init(c);
+
+	while (ok)
+	{
+		ok = parse_sum(p, c, 0) && acb_poly_length(c) <= 1;
+		if (ok && acb_poly_length(c) == 1)
+			ok = add_coeff(p, i, j, c->coeffs);
+		else if (ok)
+		{
+			/* Zero entries still count towards the degree */
+			acb_poly_one(c);
+			acb_zero(c->coeffs);
+			ok = add_coeff(p, i, j, c->coeffs);
+		}
+
+		if (accept(p, ','))
+			j++;
+		else if (accept(p, ';'))
+		{
+			i++;
+			j = 0;
+		}
+		else
+			break;
+	}
+	acb_poly_clear(c);
+	ok = ok && accept(p, '}');
+	p->rows = !ok;
+	return ok;
+}
+
+static int parse_operator (acb_ode_t ODE, parser *p)
+{
+	/* Returns 1 on success, 0 at the end of the input and -1 on errors */
+	int ok;
+	acb_poly_t unused;
+
+	skip_space(p);
+	if (p->c == EOF)
+		return 0;
+
+	p->ODE = ODE;
+	p->order = 0;
+	p->degree = 0;
+	p->rows = 0;
+	acb_ode_init_blank(ODE, 4, 2);
+
+	if (accept(p, '{'))
+	{
+		p->rows = 1;
+		ok = parse_rows(p);
+	}
+	else
+	{
+		acb_poly_init(unused);
+		ok = parse_sum(p, unused, 1);
+		acb_poly_clear(unused);
+	}
+	ok = ok && (accept(p, ';') || p->c == EOF) && p->order > 0;
+
+	if (ok)
+	{
+		finish(p);
+		return 1;
+	}
+
+	/* Skip the rest of the operator, where ';' inside braces only ends a row */
+	acb_ode_clear(ODE);
+	while ((p->c != ';' || p->rows) && p->c != EOF)
+	{
+		if (p->c == '}')
+			p->rows = 0;
+		advance(p);
+	}
+	if (p->c == ';')
+		advance(p);
+	return -1;
+}
+
+int acb_ode_parse_file (acb_ode_t ODE, FILE *in, slong prec)
+{
+	int res;
+	parser p;
+
+	p.in = in;
+	p.str = NULL;
+	p.buf = NULL;
+	p.len = 0;
+	p.alloc = 0;
+	p.prec = prec;
+
+	advance(&p);
+	res = parse_operator(ODE, &p);
+	if (p.c != EOF)
+		ungetc(p.c, in);
+
+	flint_free(p.buf);
+	return res;
+}
+
+int acb_ode_parse (acb_ode_t ODE, const char *str, slong prec)
+{
+	int res;
+	parser p;
+
+	p.in = NULL;
+	p.str = str;
+	p.buf = NULL;
+	p.len = 0;
+	p.alloc = 0;
+	p.prec = prec;
+
+	advance(&p);
+	res = parse_operator(ODE, &p);
+	skip_space(&p);
+	if (res > 0 && p.c != EOF)
+	{
+		acb_ode_clear(ODE);
+		res = -1;
+	}
+
+	flint_free(p.buf);
+	return res > 0;
+}
@@ -0,0 +1,442 @@
+#include "acb_ode.h"
+#include "cascade.h"
+
+/* Steps of r/e approach a point at distance 2^-bits from a singularity in O(bits) steps */
+#define MAX_LINE_STEPS(bits) (1024 + 4*(bits))
+
+/* Setup and memory management */
+
+void acb_ode_path_init (acb_ode_path_t path)
+{
+	path->points = NULL;
+	path->terms = NULL;
+	path->length = 0;
+	path->alloc = 0;
+}
+
+void acb_ode_path_clear (acb_ode_path_t path)
+{
+	if (path->alloc <= 0)
+		return;
+
+	_acb_vec_clear(path->points, path->alloc);
+	flint_free(path->terms);
+}
+
+void acb_ode_path_append (acb_ode_path_t path, acb_srcptr point, slong terms)
+{
+	if (path->length >= path->alloc)
+	{
+		slong alloc = FLINT_MAX(2*path->alloc, 16);
+		acb_ptr points = _acb_vec_init(alloc);
+		_acb_vec_swap(points, path->points, path->length);
+		if (path->alloc > 0)
+			_acb_vec_clear(path->points, path->alloc);
+		path->points = points;
+		path->terms = flint_realloc(path->terms, alloc * sizeof(slong));
+		path->alloc = alloc;
+	}
+	acb_set(path->points + path->length, point);
+	path->terms[path->length] = terms;
+	path->length++;
+}
+
+/* Adaptive discretization */
+
+static int local_step (arb_t step, arb_t rad, acb_ode_shift_cache_t cache, acb_ode_sing_t sing, acb_t z, slong bits)
+{
+	/* Find the distance to the nearest singularity around z, and the step
+	 * length r/e minimizing (number of steps) x (number of coefficients) */
+	if (sing != NULL)
+		acb_ode_sing_distance(rad, sing, z, bits);
+	else
+		radius_of_convergence(rad, acb_ode_shift_cache_get(cache, z), 20, bits);
+
+	if (!arb_is_finite(rad))
+	{
+		arb_pos_inf(step);
+		return 1;
+	}
+	if (!arb_is_positive(rad))
+		return 0;
+
+	arb_const_e(step, bits);
+	arb_div(step, rad, step, bits);
+	arb_get_lbound_arf(arb_midref(step), step, bits);
+	mag_zero(arb_radref(step));
+	return arb_is_positive(step);
+}
+
+static int append_line (acb_ode_path_t path, acb_ode_shift_cache_t cache, acb_ode_sing_t sing, acb_srcptr target, slong bits)
+{
+	/* Walk from the end of path to target, failing if the steps become too short to make progress */
+	int success = 1;
+	slong steps = 0;
+	arb_t rad, step, dist;
+	acb_t z, dir;
+
+	arb_init(rad);
+	arb_init(step);
+	arb_init(dist);
+	acb_init(z);
+	acb_init(dir);
+
+	acb_set(z, path->points + path->length - 1);
+	while (!acb_equal(z, target))
+	{
+		success = local_step(step, rad, cache, sing, z, bits)
+			&& arf_cmp_2exp_si(arb_midref(step), -bits) >= 0 && steps++ < MAX_LINE_STEPS(bits);
+		if (!success)
+			break;
+
+		acb_sub(dir, target, z, bits);
+		acb_abs(dist, dir, bits);
+		if (arb_le(dist, step))
+		{
+			acb_set(z, target);
+			arb_set(step, dist);
+		}
+		else
+		{
+			acb_div_arb(dir, dir, dist, bits);
+			acb_mul_arb(dir, dir, step, bits);
+			acb_add(z, z, dir, bits);
+			acb_get_mid(z, z);
+		}
+		path->terms[path->length - 1] = truncation_order(step, rad, bits);
+		acb_ode_path_append(path, z, 0);
+	}
+
+	arb_clear(rad);
+	arb_clear(step);
+	arb_clear(dist);
+	acb_clear(z);
+	acb_clear(dir);
+	return success;
+}
+
+static int append_circle (acb_ode_path_t path, acb_ode_shift_cache_t cache, acb_ode_sing_t sing,
+		acb_t center, arb_t rho, slong bits)
+{
+	/* Walk once counterclockwise around center, starting and ending at the end of path */
+	int success = 1;
+	slong start = path->length - 1;
+	arb_t rad, step, theta, two_pi;
+	acb_t z, v;
+
+	arb_init(rad);
+	arb_init(step);
+	arb_init(theta);
+	arb_init(two_pi);
+	acb_init(z);
+	acb_init(v);
+
+	arb_const_pi(two_pi, bits);
+	arb_mul_2exp_si(two_pi, two_pi, 1);
+	acb_sub(v, path->points + start, center, bits);
+
+	acb_set(z, path->points + start);
+	while (success)
+	{
+		success = local_step(step, rad, cache, sing, z, bits);
+		if (!success)
+			break;
+
+		/* An arc of length r/e has a chord no longer than r/e */
+		arb_div(step, step, rho, bits);
+		arb_add(theta, theta, step, bits);
+		if (!arb_lt(theta, two_pi))
+			acb_set(z, path->points + start);
+		else
+		{
+			/* Rotate the starting point around center */
+			arb_sin_cos(acb_imagref(z), acb_realref(z), theta, bits);
+			acb_mul(z, z, v, bits);
+			acb_add(z, z, center, bits);
+			acb_get_mid(z, z);
+		}
+		arb_mul(step, step, rho, bits);
+		path->terms[path->length - 1] = truncation_order(step, rad, bits);
+		acb_ode_path_append(path, z, 0);
+
+		if (acb_equal(z, path->points + start))
+			break;
+	}
+
+	arb_clear(rad);
+	arb_clear(step);
+	arb_clear(theta);
+	arb_clear(two_pi);
+	acb_clear(z);
+	acb_clear(v);
+	return success;
+}
+
+int _acb_ode_path_adaptive (acb_ode_path_t path, acb_ode_shift_cache_t cache, acb_srcptr corners, slong len, slong bits)
+{
+	/* Discretize the piecewise linear path through corners */
+	int success = 1;
+	path->length = 0;
+	if (len <= 0)
+		return 1;
+	acb_ode_path_append(path, corners, 0);
+	for (slong k = 1; k < len && success; k++)
+		success = append_line(path, cache, NULL, corners + k, bits);
+	return success;
+}
+
+int _acb_ode_path_circle (acb_ode_path_t path, acb_ode_shift_cache_t cache, slong bits)
+{
+	/* Discretize a circle around the origin, which avoids all other singularities */
+	int success = 1;
+	arb_t rho;
+	acb_t z;
+
+	arb_init(rho);
+	acb_init(z);
+
+	radius_of_convergence(rho, cache->base, 40, bits);
+	if (arb_is_zero(rho))
+		success = 0;
+	else if (!arb_is_finite(rho))
+		arb_one(rho);
+	else
+		arb_mul_2exp_si(rho, rho, -1);
+	arb_get_mid_arb(rho, rho);
+
+	path->length = 0;
+	acb_set_arb(z, rho);
+	acb_ode_path_append(path, z, 0);
+	acb_zero(z);
+	if (success)
+		success = append_circle(path, cache, NULL, z, rho, bits);
+
+	arb_clear(rho);
+	acb_clear(z);
+	return success;
+}
+
+/* Planning around known singularities */
+
+static int triangle_may_contain (acb_srcptr a, acb_srcptr b, acb_srcptr c, acb_srcptr p, slong bits)
+{
+	/* The point p is certainly outside, if it lies on both sides of some edges.
+	 * A vertex is not enclosed. A corner on a singular point is still rejected by
+	 * polygon_cost, since append_line fails as the steps towards it vanish */
+	int pos = 0, neg = 0;
+	acb_srcptr v[3] = {a, b, c};
+	acb_t e, f;
+
+	for (int i = 0; i < 3; i++)
+		if (acb_equal(p, v[i]))
+			return 0;
+
+	acb_init(e);
+	acb_init(f);
+
+	for (int i = 0; i < 3; i++)
+	{
+		acb_sub(e, v[(i+1) % 3], v[i], bits);
+		acb_sub(f, p, v[i], bits);
+		acb_conj(e, e);
+		acb_mul(e, e, f, bits);
+		pos += arb_is_positive(acb_imagref(e));
+		neg += arb_is_negative(acb_imagref(e));
+	}
+
+	acb_clear(e);
+	acb_clear(f);
+	return !(pos > 0 && neg > 0);
+}
+
+static slong polygon_cost (acb_ode_path_t path, acb_ode_sing_t sing, acb_srcptr corners, slong len, slong bits)
+{
+	/* Total number of coefficients along the discretized polygon */
+	slong cost = 0;
+	path->length = 0;
+	acb_ode_path_append(path, corners, 0);
+	for (slong k = 1; k < len; k++)
+		if (!append_line(path, NULL, sing, corners + k, bits))
+			return WORD_MAX;
+	for (slong k = 0; k+1 < path->length; k++)
+		cost += path->terms[k];
+	return cost;
+}
+
+int acb_ode_path_plan (acb_ode_path_t path, acb_ode_sing_t sing, acb_srcptr start, acb_srcptr end, slong bits)
+{
+	/* Push the straight line away from every singularity close to it, as long
+	 * as this reduces the cost and does not change the homotopy class */
+	slong len = 2, best, cost, seg;
+	arb_t t, d, best_d;
+	acb_t q, u, w, best_w;
+	acb_ptr corners, trial;
+
+	arb_init(t);
+	arb_init(d);
+	arb_init(best_d);
+	acb_init(q);
+	acb_init(u);
+	acb_init(w);
+	acb_init(best_w);
+	corners = _acb_vec_init(2 + sing->length);
+	trial = _acb_vec_init(2 + sing->length);
+
+	acb_set(corners, start);
+	acb_set(corners + 1, end);
+	best = polygon_cost(path, sing, corners, len, bits);
+
+	for (slong k = 0; k < sing->length; k++)
+	{
+		acb_srcptr s = sing->points + k;
+
+		/* Find the segment passing closest to s */
+		seg = -1;
+		for (slong i = 0; i+1 < len; i++)
+		{
+			acb_sub(u, corners + i + 1, corners + i, bits);
+			acb_sub(w, s, corners + i, bits);
+			acb_conj(q, u);
+			acb_mul(q, q, w, bits);
+			acb_abs(d, u, bits);
+			arb_sqr(d, d, bits);
+			arb_div(t, acb_realref(q), d, bits);
+			arb_sub_si(d, t, 1, bits);
+			if (!arb_is_positive(t) || !arb_is_negative(d))
+				continue;
+
+			acb_mul_arb(q, u, t, bits);
+			acb_add(q, q, corners + i, bits);
+			acb_sub(u, q, s, bits);
+			acb_abs(d, u, bits);
+			if (seg < 0 || arf_cmp(arb_midref(d), arb_midref(best_d)) < 0)
+			{
+				seg = i;
+				arb_set(best_d, d);
+				acb_set(best_w, q);
+			}
+		}
+		if (seg < 0 || !arb_is_positive(best_d))
+			continue;
+
+		/* Try corners at increasing distance from s */
+		acb_set(q, best_w);
+		acb_sub(u, q, s, bits);
+		slong found = 0;
+		for (slong m = 1; m <= 8; m *= 2)
+		{
+			acb_mul_si(w, u, m, bits);
+			acb_add(w, w, q, bits);
+			acb_get_mid(w, w);
+
+			int admissible = 1;
+			for (slong j = 0; j < sing->length && admissible; j++)
+				admissible = !triangle_may_contain(corners + seg, w, corners + seg + 1, sing->points + j, bits);
+			if (!admissible)
+				continue;
+
+			_acb_vec_set(trial, corners, seg + 1);
+			acb_set(trial + seg + 1, w);
+			_acb_vec_set(trial + seg + 2, corners + seg + 1, len - seg - 1);
+			cost = polygon_cost(path, sing, trial, len + 1, bits);
+			if (cost < best)
+			{
+				best = cost;
+				acb_set(best_w, w);
+				found = 1;
+			}
+		}
+		if (found)
+		{
+			for (slong i = len; i > seg + 1; i--)
+				acb_swap(corners + i, corners + i - 1);
+			acb_set(corners + seg + 1, best_w);
+			len++;
+		}
+	}
+
+	best = polygon_cost(path, sing, corners, len, bits);
+
+	_acb_vec_clear(corners, 2 + sing->length);
+	_acb_vec_clear(trial, 2 + sing->length);
+	arb_clear(t);
+	arb_clear(d);
+	arb_clear(best_d);
+	acb_clear(q);
+	acb_clear(u);
+	acb_clear(w);
+	acb_clear(best_w);
+	return best != WORD_MAX;
+}
+
+int acb_ode_path_loop (acb_ode_path_t path, acb_ode_sing_t sing, acb_srcptr base, slong k, slong bits)
+{
+	/* Walk straight towards the singularity, once around it and back again */
+	int success = 1;
+	arb_t rho, dist;
+	acb_t s, p;
+
+	arb_init(rho);
+	arb_init(dist);
+	acb_init(s);
+	acb_init(p);
+
+	/* The circle stays closer to s than to any other singularity */
+	acb_get_mid(s, sing->points + k);
+	_acb_ode_sing_distance(rho, sing, s, k, bits);
+	acb_sub(p, base, s, bits);
+	acb_abs(dist, p, bits);
+	arb_min(rho, rho, dist, bits);
+	arb_mul_2exp_si(rho, rho, -1);
+	arb_get_lbound_arf(arb_midref(rho), rho, bits);
+	mag_zero(arb_radref(rho));
+	if (!arb_is_positive(rho))
+		success = 0;
+
+	path->length = 0;
+	acb_ode_path_append(path, base, 0);
+	if (success)
+	{
+		acb_div_arb(p, p, dist, bits);
+		acb_mul_arb(p, p, rho, bits);
+		acb_add(p, p, s, bits);
+		acb_get_mid(p, p);
+		success = append_line(path, NULL, sing, p, bits)
+			&& append_circle(path, NULL, sing, s, rho, bits)
+			&& append_line(path, NULL, sing, base, bits);
+	}
+
+	arb_clear(rho);
+	arb_clear(dist);
+	acb_clear(s);
+	acb_clear(p);
+	return success;
+}
+
+int acb_ode_path_adaptive (acb_ode_path_t path, acb_ode_t ODE, acb_srcptr corners, slong len, slong bits)
+{
+	int success;
+	acb_ode_shift_cache_t cache;
+
+	/* Without corners, there is nothing to discretize */
+	if (len <= 0)
+	{
+		path->length = 0;
+		return 1;
+	}
+
+	acb_ode_shift_cache_init(cache, ODE, bits);
+	success = _acb_ode_path_adaptive(path, cache, corners, len, bits);
+	acb_ode_shift_cache_clear(cache);
+	return success;
+}
+
+int acb_ode_path_circle (acb_ode_path_t path, acb_ode_t ODE, slong bits)
+{
+	int success;
+	acb_ode_shift_cache_t cache;
+	acb_ode_shift_cache_init(cache, ODE, bits);
+	success = _acb_ode_path_circle(path, cache, bits);
+	acb_ode_shift_cache_clear(cache);
+	return success;
+}
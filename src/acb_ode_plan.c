@@ -0,0 +1,78 @@
+#include "acb_ode.h"
+
+/* Setup and memory management */
+
+void acb_ode_plan_init (acb_ode_plan_t plan, acb_ode_t ODE)
+{
+	plan->alloc = 0;
+	plan->top = NULL;
+	plan->diags = NULL;
+	acb_ode_plan_set(plan, ODE);
+}
+
+void acb_ode_plan_clear (acb_ode_plan_t plan)
+{
+	if (plan->alloc <= 0)
+		return;
+
+	_acb_vec_clear(plan->diags, plan->alloc);
+	flint_free(plan->top);
+}
+
+void acb_ode_plan_set (acb_ode_plan_t plan, acb_ode_t ODE)
+{
+	/* Sort the coefficients of ODE by the diagonals of the recurrence, reusing the memory of plan */
+	slong v = acb_ode_valuation(ODE);
+
+	plan->order = order(ODE);
+	plan->valuation = v;
+	plan->length = FLINT_MAX(degree(ODE) - v + 1, 0);
+	if (plan->length == 0)
+		return;
+
+	slong size = plan->length * (order(ODE) + 1);
+	if (plan->alloc < size)
+	{
+		acb_ode_plan_clear(plan);
+		plan->alloc = size;
+		plan->top = flint_malloc(size * sizeof(slong));
+		plan->diags = _acb_vec_init(size);
+	}
+
+	for (slong d = 0; d < plan->length; d++)
+	{
+		plan->top[d] = -1;
+		for (slong i = 0; i <= order(ODE); i++)
+		{
+			slong j = i + v + d;
+			if (j < 0 || j > degree(ODE))
+			{
+				acb_zero(acb_ode_plan_entry(plan, d, i));
+				continue;
+			}
+			acb_set(acb_ode_plan_entry(plan, d, i), acb_ode_coeff(ODE, i, j));
+			if (!acb_is_zero(acb_ode_plan_entry(plan, d, i)))
+				plan->top[d] = i;
+		}
+	}
+}
+
+/* Evaluation */
+
+void acb_ode_plan_evaluate (acb_t res, acb_ode_plan_t plan, slong d, slong b, slong prec)
+{
+	/* Compute sum_i c_{i,i+v+d} b(b-1)...(b-i+1) by Horner's scheme in the Newton basis */
+	if (d < 0 || d >= plan->length || plan->top[d] < 0)
+	{
+		acb_zero(res);
+		return;
+	}
+
+	slong i = plan->top[d];
+	acb_set(res, acb_ode_plan_entry(plan, d, i));
+	for (i--; i >= 0; i--)
+	{
+		acb_mul_si(res, res, b - i, prec);
+		acb_add(res, res, acb_ode_plan_entry(plan, d, i), prec);
+	}
+}
@@ -0,0 +1,88 @@
+#include "acb_ode.h"
+
+/* Setup and memory management */
+
+void acb_ode_shift_cache_init (acb_ode_shift_cache_t cache, acb_ode_t ODE, slong bits)
+{
+	cache->base = ODE;
+	cache->points = NULL;
+	cache->shifts = NULL;
+	cache->length = 0;
+	cache->alloc = 0;
+	cache->bits = bits;
+}
+
+void acb_ode_shift_cache_clear (acb_ode_shift_cache_t cache)
+{
+	for (slong k = 0; k < cache->length; k++)
+	{
+		acb_ode_clear(cache->shifts[k]);
+		flint_free(cache->shifts[k]);
+	}
+	if (cache->alloc > 0)
+		_acb_vec_clear(cache->points, cache->alloc);
+	flint_free(cache->shifts);
+}
+
+/* Lookup */
+
+acb_ode_struct * acb_ode_shift_cache_get (acb_ode_shift_cache_t cache, acb_srcptr a)
+{
+	/* Return the operator shifted to a, computing it from the closest known point if necessary */
+	slong best = -1;
+	mag_t dist, best_dist;
+	acb_t h;
+	acb_ode_struct *res;
+
+	for (slong k = cache->length - 1; k >= 0; k--)
+		if (acb_equal(cache->points + k, a))
+			return cache->shifts[k];
+
+	mag_init(dist);
+	mag_init(best_dist);
+	acb_init(h);
+
+	acb_get_mag(best_dist, a);
+	for (slong k = 0; k < cache->length; k++)
+	{
+		acb_sub(h, a, cache->points + k, MAG_BITS);
+		acb_get_mag(dist, h);
+		if (mag_cmp(dist, best_dist) < 0)
+		{
+			best = k;
+			mag_swap(dist, best_dist);
+		}
+	}
+
+	if (cache->length >= cache->alloc)
+	{
+		slong alloc = FLINT_MAX(2*cache->alloc, 16);
+		acb_ptr points = _acb_vec_init(alloc);
+		_acb_vec_swap(points, cache->points, cache->length);
+		if (cache->alloc > 0)
+			_acb_vec_clear(cache->points, cache->alloc);
+		cache->points = points;
+		cache->shifts = flint_realloc(cache->shifts, alloc * sizeof(acb_ode_struct*));
+		cache->alloc = alloc;
+	}
+
+	/* Shifting by a short step keeps the coefficients small */
+	res = flint_malloc(sizeof(acb_ode_struct));
+	acb_ode_init_blank(res, degree(cache->base), order(cache->base));
+	if (best < 0)
+		acb_ode_shift(res, cache->base, a, cache->bits);
+	else
+	{
+		acb_sub(h, a, cache->points + best, cache->bits);
+		acb_ode_shift(res, cache->shifts[best], h, cache->bits);
+	}
+
+	acb_set(cache->points + cache->length, a);
+	cache->shifts[cache->length] = res;
+	cache->length++;
+
+	mag_clear(dist);
+	mag_clear(best_dist);
+	acb_clear(h);
+	return res;
+}
@@ -1,5 +1,8 @@
 #include "acb_ode.h"
 
+/* Fast multipoint evaluation pays off for many points and long series */
+#define MULTIPOINT_CUTOFF 32
+
 void acb_ode_solution_init (acb_ode_solution_t sol, acb_t rho, slong mul, slong alpha)
 {
 	sol->mul = mul;
@@ -23,38 +26,131 @@ void acb_ode_solution_clear (acb_ode_solution_t sol)
 
 void acb_ode_solution_evaluate (acb_t out, acb_ode_solution_t sol, acb_t a, slong prec)
 {
-	acb_t l, p, res;
-	slong binom = 1;
+	acb_ode_solution_evaluate_vec(out, sol, a, 1, 1, prec);
+}
+
+static void generator_values (acb_ptr vals, acb_ode_solution_t sol, acb_srcptr a, slong num, slong len, slong prec)
+{
+	/* Set vals[(i*len + k)*num + j] to the k-th Taylor coefficient of g_i at a[j] */
+	slong D = 0;
+	acb_poly_struct *tay;
 
-	if (acb_is_zero(a))
+	for (slong i = 0; i < sol->M; i++)
+		D = FLINT_MAX(D, acb_poly_length(sol->gens + i));
+
+	/* The Taylor coefficients of order k are polynomials themselves, shared by all points */
+	tay = flint_malloc(sol->M * len * sizeof(acb_poly_struct));
+	for (slong i = 0; i < sol->M; i++)
 	{
-		acb_indeterminate(out);
-		return;
+		acb_poly_struct *t = tay + i*len;
+		acb_poly_init(t);
+		acb_poly_set(t, sol->gens + i);
+		for (slong k = 1; k < len; k++)
+		{
+			acb_poly_init(t + k);
+			acb_poly_derivative(t + k, t + k - 1, prec);
+			_acb_vec_scalar_div_ui(t[k].coeffs, t[k].coeffs, acb_poly_length(t + k), k, prec);
+		}
 	}
 
-	acb_init(l);
-	acb_init(p);
-	acb_init(res);
+	if (num >= MULTIPOINT_CUTOFF && D >= MULTIPOINT_CUTOFF)
+	{
+		/* One product tree for all generators and derivatives */
+		acb_ptr *tree = _acb_poly_tree_alloc(num);
+		_acb_poly_tree_build(tree, a, num, prec);
+		for (slong c = 0; c < sol->M * len; c++)
+			_acb_poly_evaluate_vec_fast_precomp(vals + c*num, tay[c].coeffs, acb_poly_length(tay + c), tree, num, prec);
+		_acb_poly_tree_free(tree, num);
+	}
+	else
+	{
+		/* One table of powers per point for all generators and derivatives */
+		acb_ptr powers = _acb_vec_init(FLINT_MAX(D, 1));
+		for (slong j = 0; j < num; j++)
+		{
+			_acb_vec_set_powers(powers, a + j, D, prec);
+			for (slong c = 0; c < sol->M * len; c++)
+				acb_dot(vals + c*num + j, NULL, 0, tay[c].coeffs, 1, powers, 1, acb_poly_length(tay + c), prec);
+		}
+		_acb_vec_clear(powers, FLINT_MAX(D, 1));
+	}
+
+	for (slong c = 0; c < sol->M * len; c++)
+		acb_poly_clear(tay + c);
+	flint_free(tay);
+}
 
-	acb_log(l, a, prec);
-	acb_poly_evaluate(res, sol->gens, a, prec);
-	for (slong i = 1; i < sol->M; i++)
+void acb_ode_solution_evaluate_vec (acb_ptr res, acb_ode_solution_t sol, acb_srcptr a, slong num, slong len, slong prec)
+{
+	/* Write the first len Taylor coefficients of z^rho sum_i binom(M-1, i) g_i(z) log(z)^(M-1-i)
+	 * at a[j] to res + j*len, as power series in t = z - a[j] */
+	acb_ptr vals, L, P, R, T, inv;
+	slong M = sol->M;
+
+	if (num <= 0 || len <= 0)
+		return;
+
+	double time = acb_ode_stats_active() ? _acb_ode_stats_clock() : 0;
+	vals = _acb_vec_init(M * len * num);
+	L = _acb_vec_init(4*len + 1);
+	P = L + len;
+	R = P + len;
+	T = R + len;
+	inv = T + len;
+
+	generator_values(vals, sol, a, num, len, prec);
+	for (slong j = 0; j < num; j++)
 	{
-		acb_mul(res, res, l, prec);
+		acb_ptr out = res + j*len;
+		if (acb_is_zero(a + j))
+		{
+			_acb_vec_indeterminate(out, len);
+			continue;
+		}
 
-		acb_poly_evaluate(p, sol->gens + i, a, prec);
-		binom = (binom * (sol->M - i + 1)) / i;
-		acb_mul_si(p, p, binom, prec);
+		/* log(a+t) = log(a) - sum_k (-t/a)^k/k, and (a+t)^rho = exp(rho log(a)) (1+t/a)^rho */
+		acb_log(L, a + j, prec);
+		acb_mul(P, L, sol->rho, prec);
+		acb_exp(P, P, prec);
+		acb_inv(inv, a + j, prec);
+		for (slong k = 1; k < len; k++)
+		{
+			acb_mul(P + k, P + k - 1, inv, prec);
+			acb_sub_si(T, sol->rho, k - 1, prec);
+			acb_mul(P + k, P + k, T, prec);
+			acb_div_si(P + k, P + k, k, prec);
+
+			if (k == 1)
+				acb_set(L + 1, inv);
+			else
+			{
+				acb_mul(L + k, L + k - 1, inv, prec);
+				acb_mul_si(L + k, L + k, -(k - 1), prec);
+				acb_div_si(L + k, L + k, k, prec);
+			}
+		}
 
-		acb_add(res, res, p, prec);
+		/* Horner's scheme in log(a+t), with binomial coefficients */
+		slong binom = 1;
+		for (slong k = 0; k < len; k++)
+			acb_set(R + k, vals + k*num + j);
+		for (slong i = 1; i < M; i++)
+		{
+			binom = (binom * (M - i)) / i;
+			_acb_poly_mullow(T, R, len, L, len, len, prec);
+			for (slong k = 0; k < len; k++)
+			{
+				acb_mul_si(R + k, vals + (i*len + k)*num + j, binom, prec);
+				acb_add(R + k, R + k, T + k, prec);
+			}
+		}
+		_acb_poly_mullow(out, R, len, P, len, len, prec);
 	}
 
-	acb_pow(p, a, sol->rho, prec);
-	acb_mul(out, res, p, prec);
-
-	acb_clear(res);
-	acb_clear(l);
-	acb_clear(p);
+	_acb_vec_clear(vals, M * len * num);
+	_acb_vec_clear(L, 4*len + 1);
+	if (acb_ode_stats_active())
+		_acb_ode_stats_add_time(ACB_ODE_STAGE_EVALUATION, time);
 }
 
 void _acb_ode_solution_update (acb_ode_solution_t sol, acb_poly_t f, slong prec)
@@ -108,6 +204,22 @@ void _acb_ode_solution_extend (acb_ode_solution_t sol, slong nu, acb_poly_t g_nu
 	acb_clear(temp);
 }
 
+void _acb_ode_solution_extend_series (acb_ode_solution_t sol, slong nu, acb_poly_t g_nu, slong prec)
+{
+	/* The i-th generator takes i! times the coefficient of (rho - rho_0)^i */
+	for (slong i = 0; i < sol->M; i++)
+	{
+		if (i < acb_poly_length(g_nu))
+			acb_poly_set_coeff_acb(sol->gens + i, nu, g_nu->coeffs + i);
+		else
+			acb_poly_set_coeff_si(sol->gens + i, nu, 0);
+		if (nu >= acb_poly_length(sol->gens + i))
+			continue;
+		for (slong k = 2; k <= i; k++)
+			acb_mul_si(sol->gens[i].coeffs + nu, sol->gens[i].coeffs + nu, k, prec);
+	}
+}
+
 void _acb_ode_solution_normalize (acb_ode_solution_t sol, slong prec)
 {
 	acb_t t;
@@ -0,0 +1,110 @@
+#include <time.h>
+#include "acb_ode.h"
+
+/* Every thread records into its own statistics, if any */
+static _Thread_local acb_ode_stats_struct *current = NULL;
+
+void acb_ode_stats_init (acb_ode_stats_t stats)
+{
+	for (int s = 0; s < ACB_ODE_NUM_STAGES; s++)
+	{
+		stats->time[s] = 0;
+		stats->calls[s] = 0;
+	}
+	stats->coeffs = 0;
+	stats->evaluations = 0;
+	stats->segments = 0;
+	stats->accuracy = ARF_PREC_EXACT;
+	stats->per_coefficient = 0;
+	stats->callback = NULL;
+	stats->data = NULL;
+}
+
+void acb_ode_stats_enable (acb_ode_stats_t stats)
+{
+	current = stats;
+}
+
+void acb_ode_stats_disable (void)
+{
+	current = NULL;
+}
+
+int acb_ode_stats_active (void)
+{
+	return current != NULL;
+}
+
+void acb_ode_stats_fprint (FILE *out, acb_ode_stats_t stats)
+{
+	const char *names[ACB_ODE_NUM_STAGES] = {"shift", "recurrence", "taylor shift", "evaluation"};
+
+	for (int s = 0; s < ACB_ODE_NUM_STAGES; s++)
+		flint_fprintf(out, "%-14s%8wd calls %12.6f s\n", names[s], stats->calls[s], stats->time[s]);
+	flint_fprintf(out, "coefficients  %wd\nevaluations   %wd\nsegments      %wd\n",
+			stats->coeffs, stats->evaluations, stats->segments);
+	if (stats->accuracy < ARF_PREC_EXACT)
+		flint_fprintf(out, "accuracy      %wd bits\n", stats->accuracy);
+}
+
+/* Hooks for the solvers, only called while the statistics are enabled */
+
+double _acb_ode_stats_clock (void)
+{
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec + 1e-9*t.tv_nsec;
+}
+
+void _acb_ode_stats_add_time (int stage, double start)
+{
+	current->time[stage] += _acb_ode_stats_clock() - start;
+	current->calls[stage]++;
+}
+
+void _acb_ode_stats_recurrence (slong coeffs, slong evaluations)
+{
+	current->coeffs += FLINT_MAX(coeffs, 0);
+	current->evaluations += FLINT_MAX(evaluations, 0);
+}
+
+static slong vec_accuracy (acb_srcptr vec, slong len)
+{
+	slong acc = ARF_PREC_EXACT;
+	for (slong i = 0; i < len; i++)
+		acc = FLINT_MIN(acc, acb_rel_accuracy_bits(vec + i));
+	return acc;
+}
+
+static void report (int kind, slong index, slong terms, slong accuracy, acb_srcptr value)
+{
+	acb_ode_stats_struct *stats = current;
+	acb_ode_event_struct event;
+
+	stats->accuracy = FLINT_MIN(stats->accuracy, accuracy);
+	if (stats->callback == NULL)
+		return;
+
+	event.kind = kind;
+	event.index = index;
+	event.terms = terms;
+	event.accuracy = accuracy;
+	event.value = value;
+	stats->callback(&event, stats->data);
+}
+
+void _acb_ode_stats_coefficients (acb_srcptr c, slong first, slong start, slong end)
+{
+	/* The coefficients of index start, ..., end-1 were computed, and c[i] is the one of index first + i */
+	if (!current->per_coefficient)
+		return;
+	for (slong n = start; n < end; n++)
+		report(ACB_ODE_EVENT_COEFFICIENT, n, 0, acb_rel_accuracy_bits(c + (n - first)), c + (n - first));
+}
+
+void _acb_ode_stats_segment (slong step, slong terms, acb_srcptr point, acb_srcptr vals, slong len)
+{
+	/* A step of a path ended at point, with the initial values vals of length len */
+	current->segments++;
+	report(ACB_ODE_EVENT_SEGMENT, step, terms, vec_accuracy(vals, len), point);
+}
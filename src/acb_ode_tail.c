@@ -0,0 +1,319 @@
+#include "acb_ode.h"
+
+/* Number of bisection steps when searching for the geometric ratio */
+#define RATIO_STEPS 8
+
+/* Setup and memory management */
+
+void acb_ode_tail_init (acb_ode_tail_t tail, acb_ode_plan_t plan, acb_srcptr rho, slong M, slong prec)
+{
+	/* Bound the coefficients of P_d(n-d+rho+e) as polynomials in n, with e^M = 0 */
+	slong D = FLINT_MAX(plan->length, 1) - 1;
+	slong r = (plan->length > 0) ? FLINT_MAX(plan->top[0], 0) : 0;
+	mag_t binom, t;
+	acb_t c;
+	acb_poly_t P, Q, x;
+
+	tail->order = plan->order;
+	tail->length = D + 1;
+	tail->degree = r;
+	tail->M = M;
+	tail->bounds = flint_malloc(FLINT_MAX(D * (r + 1), 1) * sizeof(mag_struct));
+	for (slong k = 0; k < D * (r + 1); k++)
+		mag_init(tail->bounds + k);
+	mag_init(tail->lead);
+	mag_init(tail->shift);
+
+	if (plan->length <= 0 || plan->top[0] < 0)
+		return;
+
+	mag_init(binom);
+	mag_init(t);
+	acb_init(c);
+	acb_poly_init(P);
+	acb_poly_init(Q);
+	acb_poly_init(x);
+
+	for (slong d = 0; d <= D; d++)
+	{
+		/* Convert from the Newton basis b(b-1)...(b-i+1) to the monomial basis in n */
+		acb_poly_zero(P);
+		for (slong i = plan->top[d]; i >= 0; i--)
+		{
+			acb_poly_zero(x);
+			acb_poly_set_coeff_si(x, 1, 1);
+			acb_poly_set_coeff_si(x, 0, -i);
+			acb_poly_mul(P, P, x, prec);
+			acb_poly_set_coeff_acb(x, 0, acb_ode_plan_entry(plan, d, i));
+			acb_poly_set_coeff_si(x, 1, 0);
+			acb_poly_add(P, P, x, prec);
+		}
+		acb_sub_si(c, rho, d, prec);
+		acb_poly_taylor_shift(Q, P, c, prec);
+
+		if (d == 0)
+		{
+			/* All roots of P_0(n+rho) lie in the disk of radius shift */
+			acb_get_mag_lower(tail->lead, Q->coeffs + r);
+			if (!mag_is_zero(tail->lead))
+				_acb_poly_root_bound_fujiwara(tail->shift, Q->coeffs, r + 1);
+			if (M > 1)
+			{
+				mag_one(t);
+				mag_add(tail->shift, tail->shift, t);
+			}
+			continue;
+		}
+
+		/* The recurrence is not of Fuchsian type */
+		if (acb_poly_degree(Q) > r)
+		{
+			mag_zero(tail->lead);
+			break;
+		}
+
+		/* The coefficient of e^k is the k-th derivative divided by k! */
+		for (slong j = 0; j <= acb_poly_degree(Q); j++)
+		{
+			mag_struct *s = acb_ode_tail_entry(tail, d, j);
+			mag_one(binom);
+			for (slong k = 0; k < M && j + k <= acb_poly_degree(Q); k++)
+			{
+				acb_get_mag(t, Q->coeffs + j + k);
+				mag_addmul(s, t, binom);
+				mag_mul_ui(binom, binom, j + k + 1);
+				mag_div_ui(binom, binom, k + 1);
+			}
+		}
+	}
+
+	acb_poly_clear(P);
+	acb_poly_clear(Q);
+	acb_poly_clear(x);
+	acb_clear(c);
+	mag_clear(binom);
+	mag_clear(t);
+}
+
+void acb_ode_tail_clear (acb_ode_tail_t tail)
+{
+	for (slong k = 0; k < (tail->length - 1) * (tail->degree + 1); k++)
+		mag_clear(tail->bounds + k);
+	flint_free(tail->bounds);
+	mag_clear(tail->lead);
+	mag_clear(tail->shift);
+}
+
+/* Bounds */
+
+void acb_ode_tail_norm (mag_t res, acb_ode_tail_t tail, const acb_poly_struct *gens, slong n)
+{
+	/* The norm of u_n = sum_k g_k[n] e^k/k! in C[e]/e^M */
+	mag_t t;
+	mag_init(t);
+
+	mag_zero(res);
+	for (slong k = 0; k < tail->M && n >= 0; k++)
+	{
+		if (n < acb_poly_length(gens + k))
+		{
+			acb_get_mag(t, gens[k].coeffs + n);
+			for (slong i = 2; i <= k; i++)
+				mag_div_ui(t, t, i);
+			mag_add(res, res, t);
+		}
+	}
+
+	mag_clear(t);
+}
+
+static void ratio_sum (mag_t res, mag_srcptr c, slong D, const mag_t beta)
+{
+	/* Upper bound for sum_d c_d beta^-d */
+	mag_t t;
+	mag_init(t);
+
+	mag_zero(res);
+	for (slong d = 1; d <= D; d++)
+	{
+		mag_pow_ui_lower(t, beta, d);
+		mag_div(t, c + d - 1, t);
+		mag_add(res, res, t);
+	}
+
+	mag_clear(t);
+}
+
+static int tail_majorant (mag_t A, mag_t beta, acb_ode_tail_t tail, const acb_poly_struct *gens, slong N)
+{
+	/* Find A and beta such that |u_n| <= A beta^(n-N) for all n >= N-D, by induction on the recurrence */
+	slong D = tail->length - 1;
+	mag_ptr c;
+	mag_t den, lo, hi, mid, s, t;
+
+	mag_init(den);
+	mag_set_ui_lower(den, N);
+	mag_sub_lower(den, den, tail->shift);
+	if (mag_is_zero(tail->lead) || mag_is_zero(den) || N < 1)
+	{
+		mag_clear(den);
+		return 0;
+	}
+
+	/* For n >= N, |P_d(n-d+rho+e)/P_0(n+rho+e)| <= c_d, as every term n^j/(n-shift)^r decreases */
+	mag_pow_ui_lower(den, den, tail->degree);
+	mag_mul_lower(den, den, tail->lead);
+
+	c = flint_malloc(FLINT_MAX(D, 1) * sizeof(mag_struct));
+	mag_init(lo);
+	mag_init(hi);
+	mag_init(mid);
+	mag_init(s);
+	mag_init(t);
+	mag_zero(A);
+
+	for (slong d = 1; d <= D; d++)
+	{
+		mag_init(c + d - 1);
+		mag_one(s);
+		for (slong j = 0; j <= tail->degree; j++)
+		{
+			mag_addmul(c + d - 1, acb_ode_tail_entry(tail, d, j), s);
+			mag_mul_ui(s, s, N);
+		}
+		mag_div(c + d - 1, c + d - 1, den);
+
+		/* Fujiwara's bound for the positive root of x^D - sum_d c_d x^(D-d) */
+		mag_root(t, c + d - 1, d);
+		mag_max(hi, hi, t);
+	}
+	mag_mul_2exp_si(hi, hi, 1);
+
+	/* Refine the ratio, keeping sum_d c_d hi^-d <= 1 */
+	mag_mul_2exp_si(lo, hi, -1);
+	for (slong i = 0; i < RATIO_STEPS && !mag_is_zero(hi); i++)
+	{
+		mag_add(mid, lo, hi);
+		mag_mul_2exp_si(mid, mid, -1);
+		ratio_sum(s, c, D, mid);
+		if (mag_cmp_2exp_si(s, 0) <= 0)
+			mag_swap(hi, mid);
+		else
+			mag_swap(lo, mid);
+	}
+
+	for (slong d = 1; d <= D; d++)
+	{
+		acb_ode_tail_norm(t, tail, gens, N - d);
+		mag_pow_ui(s, hi, d);
+		mag_mul(t, t, s);
+		mag_max(A, A, t);
+	}
+	mag_set(beta, hi);
+
+	for (slong d = 1; d <= D; d++)
+		mag_clear(c + d - 1);
+	flint_free(c);
+	mag_clear(den);
+	mag_clear(lo);
+	mag_clear(hi);
+	mag_clear(mid);
+	mag_clear(s);
+	mag_clear(t);
+	return 1;
+}
+
+void acb_ode_tail_bound (mag_t res, acb_ode_tail_t tail, const acb_poly_struct *gens, slong N, const mag_t eta)
+{
+	acb_ode_tail_bound_derivatives(res, tail, gens, N, eta, 1);
+}
+
+void acb_ode_tail_bound_derivatives (mag_ptr res, acb_ode_tail_t tail, const acb_poly_struct *gens, slong N,
+		const mag_t eta, slong len)
+{
+	/* With x = beta eta < 1, the j-th tail is A eta^(N-j) sum_{i <= j} binom(N, i) x^(j-i) / (1-x)^(j-i+1),
+	 * by Vandermonde's identity and sum_m binom(m, k) x^m = x^k / (1-x)^(k+1) */
+	mag_t A, beta, x, g, b, t, u, s;
+
+	mag_init(A);
+	mag_init(beta);
+	mag_init(x);
+	mag_init(g);
+	mag_init(b);
+	mag_init(t);
+	mag_init(u);
+	mag_init(s);
+
+	for (slong j = 0; j < len; j++)
+		mag_inf(res + j);
+	if (N >= len && tail_majorant(A, beta, tail, gens, N))
+	{
+		mag_mul(x, beta, eta);
+		if (mag_is_zero(A))
+		{
+			for (slong j = 0; j < len; j++)
+				mag_zero(res + j);
+		}
+		else if (mag_cmp_2exp_si(x, 0) < 0)
+		{
+			mag_geom_series(g, x, 0);
+			for (slong j = 0; j < len; j++)
+			{
+				mag_zero(s);
+				mag_one(b);
+				for (slong i = 0; i <= j; i++)
+				{
+					mag_pow_ui(t, x, j - i);
+					mag_mul(t, t, b);
+					mag_pow_ui(u, g, j - i + 1);
+					mag_mul(t, t, u);
+					mag_add(s, s, t);
+					mag_mul_ui(b, b, N - i);
+					mag_div_ui(b, b, i + 1);
+				}
+				mag_pow_ui(t, eta, N - j);
+				mag_mul(res + j, A, t);
+				mag_mul(res + j, res + j, s);
+			}
+		}
+	}
+
+	mag_clear(A);
+	mag_clear(beta);
+	mag_clear(x);
+	mag_clear(g);
+	mag_clear(b);
+	mag_clear(t);
+	mag_clear(u);
+	mag_clear(s);
+}
+
+int acb_ode_tail_check (mag_t err, acb_ode_tail_t tail, const acb_poly_struct *gens, slong N, const mag_t eta, slong bits)
+{
+	/* The Taylor coefficients of order i at a point of modulus eta lose about N^i against the tail */
+	mag_t scale, p, t;
+	mag_init(scale);
+	mag_init(p);
+	mag_init(t);
+
+	acb_ode_tail_bound(err, tail, gens, N, eta);
+	mag_one(p);
+	for (slong n = 0; n < N; n++)
+	{
+		acb_ode_tail_norm(t, tail, gens, n);
+		mag_mul(t, t, p);
+		mag_max(scale, scale, t);
+		mag_mul(p, p, eta);
+	}
+
+	mag_set_ui(t, N);
+	mag_pow_ui(t, t, tail->order);
+	mag_mul(t, t, err);
+	mag_mul_2exp_si(scale, scale, -bits);
+	int res = mag_is_finite(t) && mag_cmp(t, scale) <= 0;
+
+	mag_clear(scale);
+	mag_clear(p);
+	mag_clear(t);
+	return res;
+}
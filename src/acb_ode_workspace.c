@@ -0,0 +1,55 @@
+#include "acb_ode.h"
+
+/* Setup and memory management */
+
+void acb_ode_workspace_init (acb_ode_workspace_t ws)
+{
+	ws->vec = NULL;
+	ws->vec_alloc = 0;
+	ws->polys = NULL;
+	ws->polys_alloc = 0;
+	acb_ode_init_blank(&ws->ODE, -1, 0);
+	ws->plan.alloc = 0;
+	ws->plan.length = 0;
+	ws->plan.top = NULL;
+	ws->plan.diags = NULL;
+}
+
+void acb_ode_workspace_clear (acb_ode_workspace_t ws)
+{
+	if (ws->vec_alloc > 0)
+		_acb_vec_clear(ws->vec, ws->vec_alloc);
+	for (slong k = 0; k < ws->polys_alloc; k++)
+		acb_poly_clear(ws->polys + k);
+	flint_free(ws->polys);
+	acb_ode_clear(&ws->ODE);
+	acb_ode_plan_clear(&ws->plan);
+}
+
+/* Scratch space */
+
+acb_ptr acb_ode_workspace_vec (acb_ode_workspace_t ws, slong len)
+{
+	/* The contents are not preserved when the vector grows */
+	if (ws->vec_alloc < len)
+	{
+		if (ws->vec_alloc > 0)
+			_acb_vec_clear(ws->vec, ws->vec_alloc);
+		ws->vec_alloc = FLINT_MAX(len, 2*ws->vec_alloc);
+		ws->vec = _acb_vec_init(ws->vec_alloc);
+	}
+	return ws->vec;
+}
+
+acb_poly_struct * acb_ode_workspace_polys (acb_ode_workspace_t ws, slong num)
+{
+	if (ws->polys_alloc < num)
+	{
+		slong alloc = FLINT_MAX(num, 2*ws->polys_alloc);
+		ws->polys = flint_realloc(ws->polys, alloc * sizeof(acb_poly_struct));
+		for (slong k = ws->polys_alloc; k < alloc; k++)
+			acb_poly_init(ws->polys + k);
+		ws->polys_alloc = alloc;
+	}
+	return ws->polys;
+}
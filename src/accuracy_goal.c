@@ -0,0 +1,132 @@
+#include "cascade.h"
+
+/* Large goals are first attempted at this precision, to measure the cancellation */
+#define PILOT_PREC 64
+
+/* Extra bits on top of the goal and the measured loss */
+#define GUARD_BITS 16
+
+/* Restarts give up beyond this precision */
+#define MAX_PRECISION(goal) (8*(goal) + 256)
+
+/* Static functions */
+
+static slong poly_accuracy (acb_srcptr coeffs, slong len)
+{
+	slong acc = ARF_PREC_EXACT;
+	for (slong i = 0; i < len; i++)
+		if (!acb_is_zero(coeffs + i))
+			acc = FLINT_MIN(acc, acb_rel_accuracy_bits(coeffs + i));
+	return acc;
+}
+
+static slong first_precision (slong goal)
+{
+	return FLINT_MIN(goal + GUARD_BITS, PILOT_PREC);
+}
+
+static slong next_precision (slong wp, slong acc, slong prev_acc, slong goal)
+{
+	/* Returns 0 if no further attempt is necessary or useful */
+	if (acc >= goal || (wp > PILOT_PREC && acc <= prev_acc))
+		return 0;
+
+	/* The number of bits lost hardly depends on the working precision */
+	if (acc <= 0)
+		wp = FLINT_MAX(2*wp, goal + GUARD_BITS);
+	else
+		wp = FLINT_MAX(wp + GUARD_BITS, goal + (wp - acc) + GUARD_BITS);
+
+	return (wp > MAX_PRECISION(goal)) ? 0 : wp;
+}
+
+/* Solvers */
+
+int acb_ode_solve_fuchs_goal (acb_poly_t res, acb_ode_t ODE, slong num_of_coeffs, slong goal)
+{
+	slong acc = -ARF_PREC_EXACT, prev_acc;
+	acb_poly_t out;
+	acb_ode_plan_t plan;
+
+	acb_poly_init(out);
+	acb_ode_plan_init(plan, ODE);
+
+	for (slong wp = first_precision(goal); wp > 0; wp = next_precision(wp, acc, prev_acc, goal))
+	{
+		acb_poly_set(out, res);
+		_acb_ode_solve_fuchs(out, plan, num_of_coeffs, wp);
+		prev_acc = acc;
+		acc = poly_accuracy(out->coeffs, acb_poly_length(out));
+	}
+	acb_poly_swap(res, out);
+
+	acb_ode_plan_clear(plan);
+	acb_poly_clear(out);
+	return acc >= goal;
+}
+
+int acb_ode_solve_frobenius_goal (acb_ode_solution_t sol, acb_ode_t ODE, slong sol_degree, slong goal)
+{
+	slong acc = -ARF_PREC_EXACT, prev_acc;
+	acb_poly_struct *input = flint_malloc(sol->M * sizeof(acb_poly_struct));
+
+	for (slong i = 0; i < sol->M; i++)
+	{
+		acb_poly_init(input + i);
+		acb_poly_set(input + i, sol->gens + i);
+	}
+
+	for (slong wp = first_precision(goal); wp > 0; wp = next_precision(wp, acc, prev_acc, goal))
+	{
+		for (slong i = 0; i < sol->M; i++)
+			acb_poly_set(sol->gens + i, input + i);
+		acb_ode_solve_frobenius(sol, ODE, sol_degree, wp);
+
+		prev_acc = acc;
+		acc = ARF_PREC_EXACT;
+		for (slong i = 0; i < sol->M; i++)
+			acc = FLINT_MIN(acc, poly_accuracy(sol->gens[i].coeffs, acb_poly_length(sol->gens + i)));
+	}
+
+	for (slong i = 0; i < sol->M; i++)
+		acb_poly_clear(input + i);
+	flint_free(input);
+	return acc >= goal;
+}
+
+int analytic_continuation_goal (acb_poly_t res, acb_ode_t ODE, acb_srcptr corners, slong len, slong goal)
+{
+	/* The path only depends on the goal, and is kept between the attempts. Its numbers of terms
+	 * are only upper limits, so they are chosen for the largest precision ever tried. The tail
+	 * bound of every step is included in the result, so the accuracy is that of the true values */
+	slong acc = -ARF_PREC_EXACT, prev_acc;
+	acb_poly_t out;
+	acb_ode_path_t path;
+	acb_ode_shift_cache_t cache;
+
+	acb_poly_init(out);
+	acb_ode_path_init(path);
+
+	if (!acb_ode_path_adaptive(path, ODE, corners, len, MAX_PRECISION(goal)))
+	{
+		acb_ode_path_clear(path);
+		acb_poly_clear(out);
+		return 0;
+	}
+
+	for (slong wp = first_precision(goal); wp > 0; wp = next_precision(wp, acc, prev_acc, goal))
+	{
+		acb_poly_set(out, res);
+		acb_ode_shift_cache_init(cache, ODE, wp);
+		_analytic_continuation_path(out, cache, path, wp);
+		acb_ode_shift_cache_clear(cache);
+
+		prev_acc = acc;
+		acc = poly_accuracy(out->coeffs, acb_poly_length(out));
+	}
+	acb_poly_swap(res, out);
+
+	acb_ode_path_clear(path);
+	acb_poly_clear(out);
+	return acc >= goal;
+}
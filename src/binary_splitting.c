@@ -0,0 +1,424 @@
+#include <flint/fmpz_mat.h>
+#include "acb_ode.h"
+#include "cascade.h"
+
+/* Matrices and numbers over the Gaussian integers. A number is stored as a
+ * pair of fmpz (real part, imaginary part), a matrix as a pair of fmpz_mat. */
+
+typedef struct {
+	fmpz_mat_t re;
+	fmpz_mat_t im;
+} gauss_mat_struct;
+
+typedef gauss_mat_struct gauss_mat_t[1];
+
+typedef struct {
+	slong s;		/* depth of the recurrence */
+	slong m;		/* number of Taylor coefficients to compute */
+	slong width;		/* entries per diagonal */
+	slong num;		/* number of entries */
+	int real;		/* all data is real */
+	slong *top;
+	fmpz *diags;		/* the recurrence, scaled to Gaussian integers */
+	fmpz *powers;		/* p^k q^(s-k) for 0 <= k <= s */
+} bsplit_struct;
+
+typedef bsplit_struct bsplit_t[1];
+
+static void gauss_mat_init (gauss_mat_t A, slong n)
+{
+	fmpz_mat_init(A->re, n, n);
+	fmpz_mat_init(A->im, n, n);
+}
+
+static void gauss_mat_clear (gauss_mat_t A)
+{
+	fmpz_mat_clear(A->re);
+	fmpz_mat_clear(A->im);
+}
+
+static void gauss_mat_mul (gauss_mat_t C, gauss_mat_t A, gauss_mat_t B, int real)
+{
+	if (real)
+	{
+		fmpz_mat_mul(C->re, A->re, B->re);
+		return;
+	}
+
+	/* Karatsuba: three real products instead of four */
+	fmpz_mat_t t1, t2, t3, t4;
+	slong n = fmpz_mat_nrows(A->re);
+	fmpz_mat_init(t1, n, n);
+	fmpz_mat_init(t2, n, n);
+	fmpz_mat_init(t3, n, n);
+	fmpz_mat_init(t4, n, n);
+
+	fmpz_mat_mul(t1, A->re, B->re);
+	fmpz_mat_mul(t2, A->im, B->im);
+	fmpz_mat_add(t3, A->re, A->im);
+	fmpz_mat_add(t4, B->re, B->im);
+	fmpz_mat_mul(t3, t3, t4);
+
+	fmpz_mat_sub(C->re, t1, t2);
+	fmpz_mat_sub(t3, t3, t1);
+	fmpz_mat_sub(C->im, t3, t2);
+
+	fmpz_mat_clear(t1);
+	fmpz_mat_clear(t2);
+	fmpz_mat_clear(t3);
+	fmpz_mat_clear(t4);
+}
+
+static void gauss_mul (fmpz *z, const fmpz *x, const fmpz *y)
+{
+	fmpz_t re, im;
+	fmpz_init(re);
+	fmpz_init(im);
+
+	fmpz_mul(re, x, y);
+	fmpz_submul(re, x + 1, y + 1);
+	fmpz_mul(im, x, y + 1);
+	fmpz_addmul(im, x + 1, y);
+
+	fmpz_swap(z, re);
+	fmpz_swap(z + 1, im);
+
+	fmpz_clear(re);
+	fmpz_clear(im);
+}
+
+static int gauss_is_zero (const fmpz *x)
+{
+	return fmpz_is_zero(x) && fmpz_is_zero(x + 1);
+}
+
+static void gauss_get_acb (acb_t res, const fmpz *x, slong prec)
+{
+	arb_set_round_fmpz(acb_realref(res), x, prec);
+	arb_set_round_fmpz(acb_imagref(res), x + 1, prec);
+}
+
+/* Exact conversion */
+
+static int acb_get_fmpz_2exp (fmpz *m, fmpz *e, const acb_t x)
+{
+	/* Write x = (m[0] + i*m[1]) * 2^e[i] with integers m, e */
+	if (!acb_is_exact(x) || !acb_is_finite(x))
+		return 0;
+	arf_get_fmpz_2exp(m, e, arb_midref(acb_realref(x)));
+	arf_get_fmpz_2exp(m + 1, e + 1, arb_midref(acb_imagref(x)));
+	return fmpz_fits_si(e) && fmpz_fits_si(e + 1);
+}
+
+static void gauss_scale (fmpz *z, const fmpz *m, const fmpz *e, slong emin)
+{
+	/* Set z = m * 2^(e - emin), componentwise */
+	for (slong k = 0; k < 2; k++)
+		fmpz_mul_2exp(z + k, m + k, fmpz_get_si(e + k) - emin);
+}
+
+static int bsplit_init (bsplit_t B, acb_ode_plan_t plan, const fmpz *p, const fmpz_t q, slong len)
+{
+	slong num = plan->length * (plan->order + 1);
+	slong emin = WORD_MAX;
+	int success = 1;
+	fmpz *m, *e;
+
+	B->s = FLINT_MAX(plan->length - 1, 0);
+	B->m = len;
+	B->width = plan->order + 1;
+	B->num = num;
+	B->real = fmpz_is_zero(p + 1);
+	B->top = plan->top;
+	B->diags = _fmpz_vec_init(2 * num);
+	B->powers = _fmpz_vec_init(2 * (B->s + 1));
+
+	m = _fmpz_vec_init(2 * num);
+	e = _fmpz_vec_init(2 * num);
+
+	/* Scale the coefficients to a common power of two */
+	for (slong k = 0; k < num && success; k++)
+	{
+		success = acb_get_fmpz_2exp(m + 2*k, e + 2*k, plan->diags + k);
+		for (slong l = 0; l < 2; l++)
+			if (!fmpz_is_zero(m + 2*k + l))
+				emin = FLINT_MIN(emin, fmpz_get_si(e + 2*k + l));
+		B->real &= fmpz_is_zero(m + 2*k + 1);
+	}
+	for (slong k = 0; k < num && success; k++)
+		gauss_scale(B->diags + 2*k, m + 2*k, e + 2*k, emin);
+
+	/* Powers of the evaluation point */
+	fmpz_t t;
+	fmpz_init(t);
+	fmpz_one(B->powers);
+	for (slong k = 1; k <= B->s; k++)
+		gauss_mul(B->powers + 2*k, B->powers + 2*(k-1), p);
+	for (slong k = 0; k < B->s; k++)
+	{
+		fmpz_pow_ui(t, q, B->s - k);
+		fmpz_mul(B->powers + 2*k, B->powers + 2*k, t);
+		fmpz_mul(B->powers + 2*k + 1, B->powers + 2*k + 1, t);
+	}
+	fmpz_clear(t);
+
+	_fmpz_vec_clear(m, 2 * num);
+	_fmpz_vec_clear(e, 2 * num);
+	return success;
+}
+
+static void bsplit_clear (bsplit_t B)
+{
+	_fmpz_vec_clear(B->diags, 2 * B->num);
+	_fmpz_vec_clear(B->powers, 2 * (B->s + 1));
+}
+
+static void bsplit_diagonal (fmpz *res, bsplit_t B, slong d, slong b)
+{
+	/* Same as acb_ode_plan_evaluate, but over the Gaussian integers */
+	slong i = B->top[d];
+	fmpz_zero(res);
+	fmpz_zero(res + 1);
+	if (i < 0)
+		return;
+
+	fmpz_set(res, B->diags + 2*(d*B->width + i));
+	fmpz_set(res + 1, B->diags + 2*(d*B->width + i) + 1);
+	for (i--; i >= 0; i--)
+	{
+		fmpz_mul_si(res, res, b - i);
+		fmpz_mul_si(res + 1, res + 1, b - i);
+		fmpz_add(res, res, B->diags + 2*(d*B->width + i));
+		fmpz_add(res + 1, res + 1, B->diags + 2*(d*B->width + i) + 1);
+	}
+}
+
+static void bsplit_leaf (gauss_mat_t M, fmpz *D, bsplit_t B, slong n)
+{
+	/* The state (b_{n-1}, ..., b_{n-s}, T_0, ..., T_{m-1}) is mapped to
+	 * D(n) (b_n, ..., b_{n-s+1}, T_0', ..., T_{m-1}') where b_n = a_n x^n
+	 * and T_j = sum binom(n,j) b_n. */
+	slong s = B->s;
+	fmpz *P = _fmpz_vec_init(2);
+	fmpz_t binom;
+	fmpz_init(binom);
+
+	fmpz_mat_zero(M->re);
+	fmpz_mat_zero(M->im);
+
+	bsplit_diagonal(D, B, 0, n);
+	gauss_mul(D, D, B->powers);
+
+	for (slong k = 1; k <= s; k++)
+	{
+		bsplit_diagonal(P, B, k, n - k);
+		gauss_mul(P, P, B->powers + 2*k);
+		fmpz_neg(fmpz_mat_entry(M->re, 0, k - 1), P);
+		fmpz_neg(fmpz_mat_entry(M->im, 0, k - 1), P + 1);
+	}
+	for (slong r = 1; r < s; r++)
+	{
+		fmpz_set(fmpz_mat_entry(M->re, r, r - 1), D);
+		fmpz_set(fmpz_mat_entry(M->im, r, r - 1), D + 1);
+	}
+	for (slong j = 0; j < B->m; j++)
+	{
+		fmpz_set(fmpz_mat_entry(M->re, s + j, s + j), D);
+		fmpz_set(fmpz_mat_entry(M->im, s + j, s + j), D + 1);
+		if (j > n)
+			continue;
+		fmpz_bin_uiui(binom, n, j);
+		for (slong k = 0; k < s; k++)
+		{
+			fmpz_mul(fmpz_mat_entry(M->re, s + j, k), fmpz_mat_entry(M->re, 0, k), binom);
+			fmpz_mul(fmpz_mat_entry(M->im, s + j, k), fmpz_mat_entry(M->im, 0, k), binom);
+		}
+	}
+
+	fmpz_clear(binom);
+	_fmpz_vec_clear(P, 2);
+}
+
+static int bsplit_product (gauss_mat_t M, fmpz *D, bsplit_t B, slong a, slong b)
+{
+	/* Compute M(b-1) ... M(a) and D(b-1) ... D(a). Returns 0 if some D(n) vanishes */
+	if (b - a == 1)
+	{
+		bsplit_leaf(M, D, B, a);
+		return !gauss_is_zero(D);
+	}
+
+	int success;
+	slong mid = a + (b - a)/2;
+	gauss_mat_t L;
+	fmpz *DL = _fmpz_vec_init(2);
+	gauss_mat_init(L, B->s + B->m);
+
+	success = bsplit_product(M, D, B, mid, b);
+	if (success)
+		success = bsplit_product(L, DL, B, a, mid);
+	if (success)
+	{
+		gauss_mat_mul(M, M, L, B->real);
+		gauss_mul(D, D, DL);
+	}
+
+	gauss_mat_clear(L);
+	_fmpz_vec_clear(DL, 2);
+	return success;
+}
+
+/* Evaluation */
+
+int _acb_ode_evaluate_bsplit (acb_poly_t res, acb_ode_plan_t plan, const fmpz *p, const fmpz_t q,
+		slong num_of_coeffs, slong len, slong bits)
+{
+	/* Evaluate the first len Taylor coefficients of the truncated series at p/q */
+	if (gauss_is_zero(p))
+	{
+		_acb_ode_solve_fuchs(res, plan, num_of_coeffs, bits);
+		acb_poly_truncate(res, len);
+		return 1;
+	}
+
+	bsplit_t B;
+	if (plan->length <= 0)
+		return 0;
+	if (!bsplit_init(B, plan, p, q, len))
+	{
+		bsplit_clear(B);
+		return 0;
+	}
+
+	slong s = B->s, dim = B->s + B->m;
+	slong n0 = FLINT_MIN(FLINT_MAX(-plan->valuation, 0), num_of_coeffs + 1);
+	int success = 1;
+
+	acb_t x, xn, t;
+	acb_ptr Y = _acb_vec_init(dim);
+	fmpz *D = _fmpz_vec_init(2);
+	fmpz_t binom;
+	acb_init(x);
+	acb_init(xn);
+	acb_init(t);
+	fmpz_init(binom);
+
+	gauss_get_acb(x, p, bits);
+	acb_div_fmpz(x, x, q, bits);
+
+	/* The state after the initial values */
+	acb_one(xn);
+	for (slong n = 0; n < n0; n++)
+	{
+		acb_poly_get_coeff_acb(t, res, n);
+		acb_mul(t, t, xn, bits);
+		if (n0 - n <= s)
+			acb_set(Y + (n0 - 1 - n), t);
+		for (slong j = 0; j < B->m && j <= n; j++)
+		{
+			fmpz_bin_uiui(binom, n, j);
+			acb_addmul_fmpz(Y + s + j, t, binom, bits);
+		}
+		acb_mul(xn, xn, x, bits);
+	}
+
+	/* The recurrence */
+	if (n0 <= num_of_coeffs)
+	{
+		gauss_mat_t M;
+		acb_ptr Z = _acb_vec_init(dim);
+		gauss_mat_init(M, dim);
+
+		success = bsplit_product(M, D, B, n0, num_of_coeffs + 1);
+		for (slong r = 0; r < dim && success; r++)
+		{
+			for (slong c = 0; c < dim; c++)
+			{
+				fmpz_set(binom, fmpz_mat_entry(M->re, r, c));
+				acb_addmul_fmpz(Z + r, Y + c, binom, bits);
+				if (B->real)
+					continue;
+				acb_mul_fmpz(t, Y + c, fmpz_mat_entry(M->im, r, c), bits);
+				acb_mul_onei(t, t);
+				acb_add(Z + r, Z + r, t, bits);
+			}
+		}
+		gauss_get_acb(t, D, bits);
+		_acb_vec_scalar_div(Y, Z, dim, t, bits);
+
+		gauss_mat_clear(M);
+		_acb_vec_clear(Z, dim);
+	}
+
+	/* Undo the scaling by x^j */
+	if (success)
+	{
+		acb_poly_fit_length(res, len);
+		acb_one(xn);
+		for (slong j = 0; j < len; j++)
+		{
+			acb_div(t, Y + s + j, xn, bits);
+			acb_poly_set_coeff_acb(res, j, t);
+			acb_mul(xn, xn, x, bits);
+		}
+		acb_poly_truncate(res, len);
+	}
+
+	acb_clear(x);
+	acb_clear(xn);
+	acb_clear(t);
+	fmpz_clear(binom);
+	_acb_vec_clear(Y, dim);
+	_fmpz_vec_clear(D, 2);
+	bsplit_clear(B);
+	return success;
+}
+
+int acb_ode_evaluate_bsplit (acb_poly_t res, acb_ode_t ODE, acb_t x, slong num_of_coeffs, slong len, slong bits)
+{
+	int success;
+	fmpz *p, *e;
+	fmpz_t q;
+	acb_ode_plan_t plan;
+
+	p = _fmpz_vec_init(2);
+	e = _fmpz_vec_init(2);
+	fmpz_init(q);
+
+	/* Write x = p/q with q a power of two */
+	success = acb_get_fmpz_2exp(p, e, x);
+	if (success)
+	{
+		slong emin = 0;
+		for (slong k = 0; k < 2; k++)
+			if (!fmpz_is_zero(p + k))
+				emin = FLINT_MIN(emin, fmpz_get_si(e + k));
+		gauss_scale(p, p, e, emin);
+		fmpz_one(q);
+		fmpz_mul_2exp(q, q, -emin);
+
+		acb_ode_plan_init(plan, ODE);
+		success = _acb_ode_evaluate_bsplit(res, plan, p, q, num_of_coeffs, len, bits);
+		acb_ode_plan_clear(plan);
+	}
+
+	_fmpz_vec_clear(p, 2);
+	_fmpz_vec_clear(e, 2);
+	fmpz_clear(q);
+	return success;
+}
+
+int acb_ode_evaluate_bsplit_fmpq (acb_poly_t res, acb_ode_t ODE, fmpq_t x, slong num_of_coeffs, slong len, slong bits)
+{
+	int success;
+	fmpz *p = _fmpz_vec_init(2);
+	acb_ode_plan_t plan;
+
+	fmpz_set(p, fmpq_numref(x));
+	acb_ode_plan_init(plan, ODE);
+	success = _acb_ode_evaluate_bsplit(res, plan, p, fmpq_denref(x), num_of_coeffs, len, bits);
+	acb_ode_plan_clear(plan);
+
+	_fmpz_vec_clear(p, 2);
+	return success;
+}
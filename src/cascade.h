@@ -8,15 +8,137 @@
 void	radius_of_convergence (arb_t rad_of_conv, acb_ode_t ODE, slong n, slong bits);
 slong	truncation_order (arb_t eta, arb_t alpha, slong bits);
 
+/* ============================== Singularities ============================= */
+
+#define ACB_ODE_SING_REGULAR	0
+#define ACB_ODE_SING_APPARENT	1
+#define ACB_ODE_SING_IRREGULAR	2
+#define ACB_ODE_SING_UNKNOWN	3
+
+typedef struct {
+	acb_ptr points;		/* pairwise disjoint enclosures */
+	slong *mul;		/* number of roots of the leading coefficient in points[k] */
+	int *type;
+	slong length;
+} acb_ode_sing_struct;
+
+typedef acb_ode_sing_struct acb_ode_sing_t[1];
+
+void	acb_ode_sing_init (acb_ode_sing_t sing);
+void	acb_ode_sing_clear (acb_ode_sing_t sing);
+
+void	acb_ode_singularities (acb_ode_sing_t sing, acb_ode_t ODE, slong prec);
+void	acb_ode_sing_distance (arb_t rad, acb_ode_sing_t sing, acb_t z, slong prec);
+void	_acb_ode_sing_distance (arb_t rad, acb_ode_sing_t sing, acb_t z, slong skip, slong prec);
+slong	_acb_ode_cluster_roots (acb_ptr points, slong *mul, slong n, slong prec);
+slong	_acb_ode_find_roots (acb_ptr roots, slong *mul, const acb_poly_t f, slong prec);
+int	_acb_ode_multiple_root (acb_t s, const acb_poly_t f, const acb_t z, slong m, slong prec);
+
 /* ============================== Fuchs Solver ============================== */
 
+void	_acb_ode_solve_fuchs (acb_poly_t res, acb_ode_plan_t plan, slong deg, slong bits);
+void	_acb_ode_solve_fuchs_range (acb_poly_t res, acb_ode_plan_t plan, slong start, slong deg, slong bits);
 void	acb_ode_solve_fuchs (acb_poly_t res, acb_ode_t ODE, slong deg, slong bits);
+void	acb_ode_solve_fuchs_ws (acb_poly_t res, acb_ode_t ODE, slong deg, acb_ode_workspace_t ws, slong bits);
+slong	_acb_ode_solve_fuchs_tail (acb_poly_t res, mag_t err, acb_ode_plan_t plan, acb_ode_tail_t tail,
+		const mag_t eta, slong max_deg, slong bits);
+slong	acb_ode_solve_fuchs_tail (acb_poly_t res, mag_t err, acb_ode_t ODE, const mag_t eta, slong max_deg, slong bits);
+slong	acb_ode_solve_fuchs_tail_ws (acb_poly_t res, mag_t err, acb_ode_t ODE, const mag_t eta, slong max_deg,
+		acb_ode_workspace_t ws, slong bits);
+
+/* Coefficients one at a time, keeping only the part the recurrence needs */
+typedef struct {
+	acb_ode_plan_struct *plan;	/* not owned */
+	acb_ptr window;		/* coefficients of index first, ..., n-1 */
+	acb_ptr temp;
+	slong width;		/* half the length of the window */
+	slong start;		/* the coefficients before start are initial values */
+	slong first;
+	slong n;		/* index of the next coefficient */
+	slong bits;
+} acb_ode_stream_struct;
+
+typedef acb_ode_stream_struct acb_ode_stream_t[1];
+
+void	acb_ode_stream_init (acb_ode_stream_t st, acb_ode_plan_t plan, acb_poly_t init, slong bits);
+void	acb_ode_stream_clear (acb_ode_stream_t st);
+void	acb_ode_stream_next (acb_t res, acb_ode_stream_t st);
+
+void	_acb_ode_solve_fuchs_evaluate (acb_ptr res, acb_ode_plan_t plan, acb_poly_t init, const acb_t x,
+		slong deg, slong len, slong bits);
+void	acb_ode_solve_fuchs_evaluate (acb_ptr res, acb_ode_t ODE, acb_poly_t init, const acb_t x,
+		slong deg, slong len, slong bits);
+
+/* Several solutions at once, sharing the recurrence */
+void	_acb_ode_solve_fuchs_block (acb_poly_struct *res, slong num, acb_ode_plan_t plan, slong deg, slong bits);
+void	acb_ode_solve_fuchs_block (acb_poly_struct *res, slong num, acb_ode_t ODE, slong deg, slong bits);
+void	_acb_ode_solve_fuchs_evaluate_block (acb_mat_t res, acb_ode_plan_t plan, const acb_mat_t init, const acb_t x,
+		slong deg, slong bits);
+
+/* Operators depending on a parameter e, with solutions as power series in e */
+void	acb_ode_solve_fuchs_family (acb_poly_struct *res, slong len, acb_ode_family_t F, slong deg, slong bits);
+void	acb_ode_family_series_evaluate (acb_poly_t res, const acb_poly_struct *sol, slong len, const acb_t e, slong bits);
+
+/* Machine precision, with certified error bounds */
+int	_acb_ode_solve_fuchs_d (acb_poly_t res, acb_ode_plan_t plan, slong deg);
+int	acb_ode_solve_fuchs_d (acb_poly_t res, acb_ode_t ODE, slong deg);
+int	_acb_ode_solve_fuchs_evaluate_d (acb_ptr res, acb_ode_plan_t plan, acb_poly_t init, const acb_t x,
+		slong deg, slong len);
+int	analytic_continuation_d (acb_poly_t res, acb_ode_t ODE, acb_srcptr path, slong len, slong deg);
+int	acb_ode_solution_evaluate_d (acb_t res, acb_ode_solution_t sol, const acb_t x);
+
+/* Binary splitting for exact operators */
+int	_acb_ode_evaluate_bsplit (acb_poly_t res, acb_ode_plan_t plan, const fmpz *p, const fmpz_t q,
+		slong deg, slong len, slong bits);
+int	acb_ode_evaluate_bsplit (acb_poly_t res, acb_ode_t ODE, acb_t x, slong deg, slong len, slong bits);
+int	acb_ode_evaluate_bsplit_fmpq (acb_poly_t res, acb_ode_t ODE, fmpq_t x, slong deg, slong len, slong bits);
+
+/* Paths for the analytic continuation */
+typedef struct {
+	acb_ptr points;
+	slong *terms;		/* number of coefficients for the step from points[i] */
+	slong length;
+	slong alloc;
+} acb_ode_path_struct;
+
+typedef acb_ode_path_struct acb_ode_path_t[1];
+
+void	acb_ode_path_init (acb_ode_path_t path);
+void	acb_ode_path_clear (acb_ode_path_t path);
+void	acb_ode_path_append (acb_ode_path_t path, acb_srcptr point, slong terms);
+
+int	_acb_ode_path_adaptive (acb_ode_path_t path, acb_ode_shift_cache_t cache, acb_srcptr corners, slong len, slong bits);
+int	_acb_ode_path_circle (acb_ode_path_t path, acb_ode_shift_cache_t cache, slong bits);
+int	acb_ode_path_adaptive (acb_ode_path_t path, acb_ode_t ODE, acb_srcptr corners, slong len, slong bits);
+int	acb_ode_path_circle (acb_ode_path_t path, acb_ode_t ODE, slong bits);
+
+int	acb_ode_path_plan (acb_ode_path_t path, acb_ode_sing_t sing, acb_srcptr start, acb_srcptr end, slong bits);
+int	acb_ode_path_loop (acb_ode_path_t path, acb_ode_sing_t sing, acb_srcptr base, slong k, slong bits);
 
 /* Compute analytic continuation and monodromy */
 void	analytic_continuation (acb_poly_t res, acb_ode_t ODE, acb_srcptr path,
 		slong len, slong deg, slong bits);
+void	analytic_continuation_ws (acb_poly_t res, acb_ode_t ODE, acb_srcptr path,
+		slong len, slong deg, acb_ode_workspace_t ws, slong bits);
+void	analytic_continuation_bit_burst (acb_poly_t res, acb_ode_t ODE, acb_srcptr path,
+		slong len, slong bits);
+slong	_acb_ode_continuation_step (acb_poly_t res, acb_ode_t ODE, const acb_t a, slong max_deg,
+		acb_ode_workspace_t ws, slong bits);
+void	_analytic_continuation_path (acb_poly_t res, acb_ode_shift_cache_t cache, acb_ode_path_t path, slong bits);
+void	analytic_continuation_path (acb_poly_t res, acb_ode_t ODE, acb_ode_path_t path, slong bits);
+
+/* Transition matrices, computed in parallel along a path */
+void	_acb_ode_transition_matrix (acb_mat_t T, acb_ode_t ODE, acb_t h, slong deg, slong bits);
+void	acb_ode_transition_matrix (acb_mat_t T, acb_ode_t ODE, acb_t a, acb_t b, slong deg, slong bits);
+void	_acb_ode_path_transition_matrix (acb_mat_t T, acb_ode_shift_cache_t cache, acb_ode_path_t path, slong bits);
+void	acb_ode_path_transition_matrix (acb_mat_t T, acb_ode_t ODE, acb_ode_path_t path, slong bits);
+
 void	find_monodromy_matrix (acb_mat_t mono, acb_ode_t ODE, slong bits);
 
+/* Target accuracy, with automatic working precision */
+int	acb_ode_solve_fuchs_goal (acb_poly_t res, acb_ode_t ODE, slong deg, slong goal);
+int	analytic_continuation_goal (acb_poly_t res, acb_ode_t ODE, acb_srcptr corners, slong len, slong goal);
+
 /* ============================ Frobenius Solver ============================ */
 
 void	indicial_polynomial (acb_poly_t result, acb_ode_t ODE, slong nu, slong shift, slong prec);
@@ -24,6 +146,54 @@ void	indicial_polynomial_evaluate (acb_t result, acb_ode_t ODE, slong nu, acb_t
 
 void	_acb_ode_solve_frobenius (acb_poly_t res, acb_ode_t ODE, acb_ode_solution_t rhs, slong sol_degree, slong prec);
 void	acb_ode_solve_frobenius (acb_ode_solution_t sol, acb_ode_t ODE, slong sol_degree, slong prec);
+void	acb_ode_solve_frobenius_ws (acb_ode_solution_t sol, acb_ode_t ODE, slong sol_degree,
+		acb_ode_workspace_t ws, slong prec);
+slong	acb_ode_solve_frobenius_tail (acb_ode_solution_t sol, mag_t err, acb_ode_t ODE, const mag_t eta,
+		slong max_degree, slong prec);
+slong	acb_ode_solve_frobenius_tail_ws (acb_ode_solution_t sol, mag_t err, acb_ode_t ODE, const mag_t eta,
+		slong max_degree, acb_ode_workspace_t ws, slong prec);
+
+/* Series which can be extended later, reusing the recurrence */
+typedef struct {
+	acb_ode_struct ODE;		/* a copy of the operator */
+	acb_ode_plan_struct plan;
+	acb_ode_tail_struct tail;	/* set up by the first tail bound */
+	acb_ode_workspace_struct ws;
+	acb_ode_solution_struct sol;	/* the coefficients computed so far */
+	acb_ode_solution_struct raw;	/* the same, without the deferred factors of the indicial polynomial */
+	acb_poly_struct *g_rho;		/* the last degree(ODE) raw coefficients */
+	acb_poly_struct *F;		/* the deferred factors f(rho + n) */
+	slong alloc;			/* number of factors */
+	slong length;			/* number of known coefficients */
+	int fuchs;
+	int finite;			/* all further coefficients are zero */
+	int has_tail;
+	slong prec;
+} acb_ode_series_struct;
+
+typedef acb_ode_series_struct acb_ode_series_t[1];
+
+#define acb_ode_series_solution(S) (&(S)->sol)
+
+void	acb_ode_series_init_fuchs (acb_ode_series_t S, acb_ode_t ODE, acb_poly_t init, slong prec);
+void	acb_ode_series_init_frobenius (acb_ode_series_t S, acb_ode_t ODE, acb_t rho, slong mul, slong alpha, slong prec);
+void	acb_ode_series_clear (acb_ode_series_t S);
+
+void	acb_ode_series_extend (acb_ode_series_t S, slong deg);
+slong	acb_ode_series_extend_tail (mag_t err, acb_ode_series_t S, const mag_t eta, slong max_deg);
+
+/* Complete local basis at a regular singular point */
+typedef struct {
+	acb_ode_solution_struct *sols;	/* one per distinct exponent */
+	slong length;
+} acb_ode_basis_struct;
+
+typedef acb_ode_basis_struct acb_ode_basis_t[1];
+
+void	acb_ode_basis_init (acb_ode_basis_t basis);
+void	acb_ode_basis_clear (acb_ode_basis_t basis);
+int	acb_ode_local_basis (acb_ode_basis_t basis, acb_ode_t ODE, slong sol_degree, slong prec);
+int	acb_ode_solve_frobenius_goal (acb_ode_solution_t sol, acb_ode_t ODE, slong sol_degree, slong goal);
 
 /* Inlines */
 
@@ -42,3 +42,86 @@ void acb_ode_hypgeom (acb_ode_t ODE, acb_t a, acb_t b, acb_t c, slong bits)
 
 	acb_clear(temp);
 }
+
+void acb_ode_hypgeom_fmpq (acb_ode_t ODE, const fmpq_t a, const fmpq_t b, const fmpq_t c)
+{
+	/* The equation multiplied by q^2, for the common denominator q, has integer coefficients */
+	fmpz_t q;
+	fmpq_t s, t;
+	fmpz_init(q);
+	fmpq_init(s);
+	fmpq_init(t);
+
+	fmpz_lcm(q, fmpq_denref(a), fmpq_denref(b));
+	fmpz_lcm(q, q, fmpq_denref(c));
+	fmpz_mul(q, q, q);
+
+	acb_ode_init_blank(ODE, 2, 2);
+	/* q^2 z*(1-z) */
+	acb_set_fmpz(acb_ode_coeff(ODE, 2, 1), q);
+	acb_neg(acb_ode_coeff(ODE, 2, 2), acb_ode_coeff(ODE, 2, 1));
+	/* q^2 (c - (a+b+1)z) */
+	fmpq_mul_fmpz(s, c, q);
+	acb_set_fmpz(acb_ode_coeff(ODE, 1, 0), fmpq_numref(s));
+	fmpq_one(t);
+	fmpq_add(s, a, b);
+	fmpq_add(s, s, t);
+	fmpq_mul_fmpz(s, s, q);
+	fmpz_neg(fmpq_numref(s), fmpq_numref(s));
+	acb_set_fmpz(acb_ode_coeff(ODE, 1, 1), fmpq_numref(s));
+	/* -q^2 ab */
+	fmpq_mul(s, a, b);
+	fmpq_mul_fmpz(s, s, q);
+	fmpz_neg(fmpq_numref(s), fmpq_numref(s));
+	acb_set_fmpz(acb_ode_coeff(ODE, 0, 0), fmpq_numref(s));
+
+	fmpz_clear(q);
+	fmpq_clear(s);
+	fmpq_clear(t);
+}
+
+void acb_ode_family_bessel (acb_ode_family_t F, const acb_t nu, slong bits)
+{
+	/* Bessel's equation for the order nu + e */
+	acb_ode_family_init(F, 3, 2, 2);
+
+	acb_set_si(acb_ode_coeff(F->ops, 2, 2), 1);
+	acb_set_si(acb_ode_coeff(F->ops, 1, 1), 1);
+	acb_set_si(acb_ode_coeff(F->ops, 0, 2), 1);
+	acb_sqr(acb_ode_coeff(F->ops, 0, 0), nu, bits);
+	acb_neg(acb_ode_coeff(F->ops, 0, 0), acb_ode_coeff(F->ops, 0, 0));
+
+	acb_mul_si(acb_ode_coeff(F->ops + 1, 0, 0), nu, -2, bits);
+	acb_set_si(acb_ode_coeff(F->ops + 2, 0, 0), -1);
+}
+
+void acb_ode_family_hypgeom (acb_ode_family_t F, const acb_t a, const acb_t b, const acb_t c, acb_srcptr dir, slong bits)
+{
+	/* The hypergeometric equation for the parameters (a, b, c) + e dir */
+	acb_ode_family_init(F, 3, 2, 2);
+
+	acb_t temp;
+	acb_init(temp);
+	/* z*(1-z) */
+	acb_set_si(acb_ode_coeff(F->ops, 2, 1), 1);
+	acb_set_si(acb_ode_coeff(F->ops, 2, 2), -1);
+	/* c - (a+b+1)z */
+	acb_set(acb_ode_coeff(F->ops, 1, 0), c);
+	acb_set(acb_ode_coeff(F->ops + 1, 1, 0), dir + 2);
+	acb_one(temp);
+	acb_add(temp, temp, a, bits);
+	acb_add(temp, temp, b, bits);
+	acb_neg(acb_ode_coeff(F->ops, 1, 1), temp);
+	acb_add(temp, dir, dir + 1, bits);
+	acb_neg(acb_ode_coeff(F->ops + 1, 1, 1), temp);
+	/* -ab */
+	acb_mul(temp, a, b, bits);
+	acb_neg(acb_ode_coeff(F->ops, 0, 0), temp);
+	acb_mul(temp, a, dir + 1, bits);
+	acb_addmul(temp, b, dir, bits);
+	acb_neg(acb_ode_coeff(F->ops + 1, 0, 0), temp);
+	acb_mul(temp, dir, dir + 1, bits);
+	acb_neg(acb_ode_coeff(F->ops + 2, 0, 0), temp);
+
+	acb_clear(temp);
+}
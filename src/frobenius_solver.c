@@ -1,3 +1,4 @@
+#include <pthread.h>
 #include "acb_ode.h"
 #include "cascade.h"
 
@@ -38,8 +39,9 @@ void indicial_polynomial (acb_poly_t result, acb_ode_t ODE, slong nu, slong shif
 	acb_clear(temp2);
 }
 
-void indicial_polynomial_evaluate (acb_t result, acb_ode_t ODE, slong nu, acb_t rho, slong shift, slong prec)
+static void indicial_evaluate (acb_t result, acb_ode_t ODE, slong nu, acb_t rho, slong shift, acb_ptr temp, slong prec)
 {
+	/* Same as indicial_polynomial_evaluate, using temp[0] and temp[1] */
 	nu += acb_ode_valuation(ODE);
 	if (nu > degree(ODE))
 	{
@@ -47,128 +49,305 @@ void indicial_polynomial_evaluate (acb_t result, acb_ode_t ODE, slong nu, acb_t
 		return;
 	}
 
-	acb_t temp1, out;
-
-	acb_init(temp1);
-	acb_init(out);
-
+	acb_zero(temp + 1);
 	slong lambda = clamp(degree(ODE)-nu, 0, order(ODE));
 	for (; lambda >= 0; lambda--)
 	{
-		acb_add_si(temp1, rho, shift - lambda, prec);
-		acb_mul(out, out, temp1, prec);
+		acb_add_si(temp, rho, shift - lambda, prec);
+		acb_mul(temp + 1, temp + 1, temp, prec);
 
 		if (lambda + nu < 0)
 			continue;
 
-		acb_add(out, out, acb_ode_coeff(ODE, lambda, lambda + nu), prec);
+		acb_add(temp + 1, temp + 1, acb_ode_coeff(ODE, lambda, lambda + nu), prec);
 	}
-	acb_set(result, out);
+	acb_set(result, temp + 1);
+}
 
-	acb_clear(temp1);
-	acb_clear(out);
+void indicial_polynomial_evaluate (acb_t result, acb_ode_t ODE, slong nu, acb_t rho, slong shift, slong prec)
+{
+	acb_ptr temp = _acb_vec_init(2);
+	indicial_evaluate(result, ODE, nu, rho, shift, temp, prec);
+	_acb_vec_clear(temp, 2);
 }
 
-void _acb_ode_solve_frobenius (acb_poly_t res, acb_ode_t ODE, acb_ode_solution_t rhs, slong sol_degree, slong prec)
+/* The polynomials f_i(rho + t) in t, computed once per exponent */
+typedef struct {
+	acb_ptr coeffs;		/* f_i in the basis of falling factorials t(t-1)...(t-k+1), at i*(order+1) + k */
+	slong *length;		/* number of coefficients of f_i */
+	slong rows;
+	slong order;
+} indicial_newton_struct;
+
+static void indicial_newton_init (indicial_newton_struct *N, acb_ode_t ODE, acb_t rho, slong prec)
 {
-	acb_t g_new, indicial, g_i;
-	acb_init(g_new);
-	acb_init(indicial);
-	acb_init(g_i);
+	/* f_i(x) = sum_l c_{l,l+i+v} (x)_l, where (x)_l = x(x-1)...(x-l+1), and by Vandermonde's identity
+	 * (rho + t)_l = sum_k binom(l, k) (rho)_(l-k) (t)_k */
+	slong v = acb_ode_valuation(ODE), w = order(ODE) + 1;
+	acb_ptr fall;
+	acb_t c;
+	fmpz_t b;
+
+	N->rows = degree(ODE) + 1;
+	N->order = order(ODE);
+	N->coeffs = _acb_vec_init(N->rows * w);
+	N->length = flint_malloc(N->rows * sizeof(slong));
+	fall = _acb_vec_init(w);
+	acb_init(c);
+	fmpz_init(b);
+
+	acb_one(fall);
+	for (slong l = 1; l < w; l++)
+	{
+		acb_sub_si(c, rho, l - 1, prec);
+		acb_mul(fall + l, fall + l - 1, c, prec);
+	}
 
-	acb_t rho;
-	acb_init(rho);
-	acb_set(rho, rhs->rho);
+	for (slong i = 0; i < N->rows; i++)
+	{
+		slong j = i + v;
+		acb_ptr d = N->coeffs + i*w;
+		N->length[i] = (j > degree(ODE)) ? 0 : clamp(degree(ODE) - j, 0, order(ODE)) + 1;
+		for (slong l = FLINT_MAX(-j, 0); l < N->length[i]; l++)
+		{
+			if (acb_is_zero(acb_ode_coeff(ODE, l, l + j)))
+				continue;
+			for (slong k = 0; k <= l; k++)
+			{
+				fmpz_bin_uiui(b, l, k);
+				acb_mul_fmpz(c, fall + l - k, b, prec);
+				acb_addmul(d + k, c, acb_ode_coeff(ODE, l, l + j), prec);
+			}
+		}
+	}
 
-	acb_poly_fit_length(res, sol_degree + 1);
-	if (acb_poly_is_zero(rhs->gens))
-		acb_poly_one(res);
-	else
+	fmpz_clear(b);
+	acb_clear(c);
+	_acb_vec_clear(fall, w);
+}
+
+static void indicial_newton_clear (indicial_newton_struct *N)
+{
+	_acb_vec_clear(N->coeffs, N->rows * (N->order + 1));
+	flint_free(N->length);
+}
+
+static void indicial_newton_evaluate (acb_t result, indicial_newton_struct *N, slong i, slong shift, slong prec)
+{
+	/* Same as indicial_evaluate, by Horner's scheme with integer factors only */
+	slong k = N->length[i] - 1;
+	acb_srcptr d = N->coeffs + i*(N->order + 1);
+
+	if (k < 0)
 	{
-		slong v = acb_ode_valuation(ODE);
-		acb_sub_si(rho, rho, v, prec);
+		acb_zero(result);
+		return;
+	}
+	acb_set(result, d + k);
+	for (k--; k >= 0; k--)
+	{
+		acb_mul_si(result, result, shift - k, prec);
+		acb_add(result, result, d + k, prec);
+	}
+}
+
+static void indicial_newton_series (acb_poly_t result, indicial_newton_struct *N, slong i, slong shift, slong len, slong prec)
+{
+	/* Same as indicial_newton_evaluate, as a power series in (rho - rho_0) truncated to length len */
+	slong K = N->length[i] - 1, n = 1;
+	acb_srcptr d = N->coeffs + i*(N->order + 1);
+
+	acb_poly_zero(result);
+	if (K < 0 || len <= 0)
+		return;
+
+	acb_poly_fit_length(result, FLINT_MIN(len, K + 1));
+	acb_set(result->coeffs, d + K);
+	for (slong k = K - 1; k >= 0; k--)
+	{
+		/* Multiply by (rho - rho_0) + shift - k in place */
+		if (n < len)
+			acb_set(result->coeffs + n, result->coeffs + n - 1);
+		for (slong j = n - 1; j > 0; j--)
+		{
+			acb_mul_si(result->coeffs + j, result->coeffs + j, shift - k, prec);
+			acb_add(result->coeffs + j, result->coeffs + j, result->coeffs + j - 1, prec);
+		}
+		acb_mul_si(result->coeffs, result->coeffs, shift - k, prec);
+		acb_add(result->coeffs, result->coeffs, d + k, prec);
+		n = FLINT_MIN(n + 1, len);
+	}
+	_acb_poly_set_length(result, n);
+	_acb_poly_normalise(result);
+}
 
-		acb_poly_get_coeff_acb(g_new, rhs->gens, 0);
-		indicial_polynomial_evaluate(indicial, ODE, 0, rho, 0, prec);
-		acb_div(g_new, g_new, indicial, prec);
+static void frobenius_single (acb_poly_t res, acb_ode_t ODE, acb_t rho, const acb_poly_t rhs, slong start,
+		slong sol_degree, acb_ptr temp, slong prec)
+{
+	/* Same as _acb_ode_solve_frobenius from the coefficient start on, using temp[0] and temp[1] */
+	acb_ptr g_new = temp, indicial = temp + 1;
+	slong rlen = acb_poly_length(rhs);
+	indicial_newton_struct N;
+
+	indicial_newton_init(&N, ODE, rho, prec);
 
+	if (start > 0)
+		;
+	else if (rlen == 0)
+		acb_poly_one(res);
+	else
+	{
+		indicial_newton_evaluate(indicial, &N, 0, 0, prec);
+		acb_div(g_new, rhs->coeffs, indicial, prec);
 		acb_poly_set_coeff_acb(res, 0, g_new);
 	}
 
-	for (slong nu = 1; nu <= sol_degree; nu++)
+	/* The coefficients are written in place, the right hand side is read before it may be overwritten */
+	slong len = FLINT_MAX(acb_poly_length(res), sol_degree + 1);
+	acb_poly_fit_length(res, len);
+	_acb_vec_zero(res->coeffs + acb_poly_length(res), len - acb_poly_length(res));
+	_acb_poly_set_length(res, len);
+
+	for (slong nu = FLINT_MAX(start, 1); nu <= sol_degree; nu++)
 	{
-		acb_poly_get_coeff_acb(g_new, rhs->gens, nu);
+		if (nu < rlen)
+			acb_set(g_new, rhs->coeffs + nu);
+		else
+			acb_zero(g_new);
 
 		slong i = clamp(nu, 1, degree(ODE));
-		indicial_polynomial_evaluate(indicial, ODE, i, rho, nu - i, prec);
+		indicial_newton_evaluate(indicial, &N, i, nu - i, prec);
 		do
 		{
-			acb_poly_get_coeff_acb(g_i, res, nu - i);
-			acb_mul(indicial, indicial, g_i, prec);
-			acb_sub(g_new, g_new, indicial, prec);
+			acb_submul(g_new, indicial, res->coeffs + (nu - i), prec);
 
 			i--;
-			indicial_polynomial_evaluate(indicial, ODE, i, rho, nu - i, prec);
+			indicial_newton_evaluate(indicial, &N, i, nu - i, prec);
 		} while (i > 0);
-		acb_div(g_new, g_new, indicial, prec);
-		acb_poly_set_coeff_acb(res, nu, g_new);
-
+		acb_div(res->coeffs + nu, g_new, indicial, prec);
 	}
-	acb_clear(g_new);
-	acb_clear(indicial);
-	acb_clear(g_i);
-	acb_clear(rho);
+	_acb_poly_normalise(res);
+	indicial_newton_clear(&N);
 }
 
-void acb_ode_solve_frobenius (acb_ode_solution_t sol, acb_ode_t ODE, slong sol_degree, slong prec)
+static void frobenius_rho (acb_t rho, acb_ode_t ODE, acb_ode_solution_t rhs, slong prec)
 {
-	if (sol->M == 1)
-	{
-		_acb_ode_solve_frobenius(sol->gens, ODE, sol, sol_degree, prec);
-		return;
-	}
+	acb_set(rho, rhs->rho);
+	if (acb_poly_length(rhs->gens) > 0)
+		acb_sub_si(rho, rho, acb_ode_valuation(ODE), prec);
+}
 
-	acb_t temp;
-	acb_poly_t indicial;
-	acb_poly_t g_new;
-	acb_poly_struct *g_rho;
+void _acb_ode_solve_frobenius (acb_poly_t res, acb_ode_t ODE, acb_ode_solution_t rhs, slong sol_degree, slong prec)
+{
+	acb_ptr temp = _acb_vec_init(5);
+	frobenius_rho(temp + 4, ODE, rhs, prec);
+	frobenius_single(res, ODE, temp + 4, rhs->gens, 0, sol_degree, temp, prec);
+	_acb_vec_clear(temp, 5);
+}
 
-	g_rho = flint_malloc( degree(ODE) * sizeof(acb_poly_struct) );
-	if (g_rho == NULL)
-		return;
+/* Exponents differing by integers share the values f_i(base + s) */
+typedef struct {
+	acb_poly_struct *entries;	/* f_i(base + s) at i*width + s, as power series of length len */
+	slong rows;
+	slong width;
+	slong len;
+} indicial_table_struct;
 
-	acb_init(temp);
-	acb_poly_init(indicial);
-	acb_poly_init(g_new);
+static void indicial_table_init (indicial_table_struct *table, acb_ode_t ODE, acb_t base, slong width, slong len, slong prec)
+{
+	table->rows = degree(ODE) + 1;
+	table->width = width;
+	table->len = len;
+	table->entries = flint_malloc(table->rows * width * sizeof(acb_poly_struct));
+
+	indicial_newton_struct N;
+	indicial_newton_init(&N, ODE, base, prec);
+	for (slong i = 0; i < table->rows; i++)
+	{
+		for (slong s = 0; s < width; s++)
+		{
+			acb_poly_init(table->entries + i*width + s);
+			indicial_newton_series(table->entries + i*width + s, &N, i, s, len, prec);
+		}
+	}
+	indicial_newton_clear(&N);
+}
 
-	for (slong i = 0; i < degree(ODE); i++)
-		acb_poly_init(g_rho + i);
-	acb_poly_one(g_rho);
+static void indicial_table_clear (indicial_table_struct *table)
+{
+	for (slong k = 0; k < table->rows * table->width; k++)
+		acb_poly_clear(table->entries + k);
+	flint_free(table->entries);
+}
 
-	for (slong i = 0; i < sol->M; i++)
+static void indicial_lookup (acb_poly_t result, indicial_newton_struct *N, slong i, slong shift, slong len,
+		indicial_table_struct *table, slong offset, slong prec)
+{
+	if (table == NULL)
+		indicial_newton_series(result, N, i, shift, len, prec);
+	else
 	{
-		acb_poly_zero(sol->gens + i);
-		acb_poly_fit_length(sol->gens + i, sol_degree + 1);
+		acb_poly_set(result, table->entries + i*table->width + offset + shift);
+		acb_poly_truncate(result, len);
 	}
-	acb_poly_one(sol->gens);
+}
 
-	for (slong nu = 1; nu <= sol_degree; nu++)
+static slong frobenius_recurrence (acb_ode_solution_t raw, acb_poly_struct *g_rho, acb_poly_struct *F, int *finite,
+		acb_ode_t ODE, slong start, slong sol_degree, acb_ode_tail_t tail, const mag_t eta,
+		indicial_table_struct *table, slong offset, acb_ode_workspace_t ws, slong prec)
+{
+	/* Compute the generators from start up to sol_degree, or until the tail bound is small enough,
+	 * without the factors F[n+1] ... F[nu] of the coefficient of index n. Returns the last index nu.
+	 * All functions of rho are power series in (rho - raw->rho), modulo (rho - raw->rho)^M.
+	 * The last degree(ODE) coefficients are kept in g_rho, times the factors applied to them so far.
+	 * If a table is given, raw->rho is its base plus offset */
+	slong nu, M = raw->M, next = tail ? FLINT_MAX(start, tail->length) : 0;
+	double time = acb_ode_stats_active() ? _acb_ode_stats_clock() : 0;
+	mag_t err;
+	acb_ptr temp;
+	acb_poly_struct *indicial, *g_new, *T;
+	indicial_newton_struct N;
+
+	indicial = acb_ode_workspace_polys(ws, 4);
+	g_new = indicial + 1;
+	T = indicial + 3;
+	temp = acb_ode_workspace_vec(ws, 1);
+	if (table == NULL)
+		indicial_newton_init(&N, ODE, raw->rho, prec);
+
+	mag_init(err);
+	if (start == 0)
+	{
+		for (slong i = 0; i < degree(ODE); i++)
+			acb_poly_zero(g_rho + i);
+		acb_poly_one(g_rho);
+		for (slong i = 0; i < M; i++)
+			acb_poly_zero(raw->gens + i);
+		acb_poly_one(raw->gens);
+		start = 1;
+	}
+	for (slong i = 0; i < M; i++)
+		acb_poly_fit_length(raw->gens + i, sol_degree + 1);
+	*finite = 0;
+
+	for (nu = start; nu <= sol_degree; nu++)
 	{
 		/* Compute the new coefficient (as a function of rho) */
 		slong i = clamp(nu, 1, degree(ODE));
-		indicial_polynomial(indicial, ODE, i, nu - i, prec);
+		indicial_lookup(indicial, &N, i, nu - i, M, table, offset, prec);
 
+		acb_poly_zero(g_new);
 		do
 		{
-			acb_poly_mul(indicial, indicial, g_rho + (i - 1), prec);
-			acb_poly_sub(g_new, g_new, indicial, prec);
+			acb_poly_mullow(T, indicial, g_rho + (i - 1), M, prec);
+			acb_poly_sub(g_new, g_new, T, prec);
 
 			i--;
-			indicial_polynomial(indicial, ODE, i, nu - i, prec);
+			indicial_lookup(indicial, &N, i, nu - i, M, table, offset, prec);
 		} while (i > 0);
 
 		/* Rescale the indicial polynomial, to keep coefficients small */
-		indicial_polynomial_evaluate(temp, ODE, 0, sol->rho, nu, prec);
+		acb_poly_get_coeff_acb(temp, indicial, 0);
 		if (!acb_contains_zero(temp))
 		{
 			acb_poly_scalar_div(indicial, indicial, temp, prec);
@@ -179,27 +358,522 @@ void acb_ode_solve_frobenius (acb_ode_solution_t sol, acb_ode_t ODE, slong sol_d
 		int all_zero = acb_poly_is_zero(g_new);
 		for (i = degree(ODE) - 1; i > 0; i--)
 		{
-			acb_poly_mul(g_rho + i, g_rho + (i - 1), indicial, prec);
+			acb_poly_mullow(g_rho + i, g_rho + (i - 1), indicial, M, prec);
 			all_zero &= acb_poly_is_zero(g_rho + i);
 		}
 		acb_poly_set(g_rho, g_new);
 
-		/* Update the G^(i) */
-		_acb_ode_solution_update(sol, indicial, prec);
-
-		/* Extend the g^(k)_nu */
-		_acb_ode_solution_extend(sol, nu, g_new, prec);
+		/* The earlier coefficients still lack the factor f(rho + nu), which is applied at the end */
+		acb_poly_swap(F + nu, indicial);
+		_acb_ode_solution_extend_series(raw, nu, g_new, prec);
 
 		if (all_zero)
+		{
+			*finite = 1;
 			break;
+		}
+
+		/* Apart from the missing factors, which are close to one, these are the final generators */
+		if (tail != NULL && nu >= next)
+		{
+			if (acb_ode_tail_check(err, tail, raw->gens, nu + 1, eta, prec))
+				break;
+			next = nu + FLINT_MAX(8, nu/8);
+		}
+	}
+
+	mag_clear(err);
+	if (table == NULL)
+		indicial_newton_clear(&N);
+	nu = FLINT_MIN(nu, sol_degree);
+	if (acb_ode_stats_active())
+	{
+		_acb_ode_stats_add_time(ACB_ODE_STAGE_RECURRENCE, time);
+		_acb_ode_stats_recurrence(nu - start + 1, 0);
+	}
+	return nu;
+}
+
+static void frobenius_finish (acb_ode_solution_t sol, acb_ode_solution_t raw, const acb_poly_struct *F, slong nu,
+		acb_ode_workspace_t ws, slong prec)
+{
+	/* Multiply the coefficient of index n by f(rho + n + 1) ... f(rho + nu), and normalize.
+	 * The coefficients are read before they are written, so sol may be raw */
+	slong M = raw->M;
+	acb_poly_struct *g_new, *S, *T;
+
+	g_new = acb_ode_workspace_polys(ws, 4) + 1;
+	S = g_new + 1;
+	T = g_new + 2;
+
+	acb_poly_one(S);
+	for (slong n = nu; n >= 0; n--)
+	{
+		acb_poly_fit_length(g_new, M);
+		for (slong k = 0; k < M; k++)
+		{
+			if (n < acb_poly_length(raw->gens + k))
+				acb_set(g_new->coeffs + k, raw->gens[k].coeffs + n);
+			else
+				acb_zero(g_new->coeffs + k);
+			for (slong j = 2; j <= k; j++)
+				acb_div_si(g_new->coeffs + k, g_new->coeffs + k, j, prec);
+		}
+		_acb_poly_set_length(g_new, M);
+		_acb_poly_normalise(g_new);
+
+		acb_poly_mullow(T, g_new, S, M, prec);
+		_acb_ode_solution_extend_series(sol, n, T, prec);
+		if (n > 0)
+		{
+			acb_poly_mullow(T, S, F + n, M, prec);
+			acb_poly_swap(S, T);
+		}
 	}
 
 	_acb_ode_solution_normalize(sol, prec);
+}
+
+static slong frobenius_series (acb_ode_solution_t sol, acb_ode_t ODE, slong sol_degree, acb_ode_tail_t tail,
+		const mag_t eta, indicial_table_struct *table, slong offset, acb_ode_workspace_t ws, slong prec)
+{
+	/* Compute the generators up to sol_degree, or until the tail bound is small enough */
+	int finite;
+	slong nu, start = 0, alloc = sol_degree;
+	acb_poly_struct *g_rho, *F;
+
+	/* With a tail bound, the factors are only allocated up to the degree reached so far */
+	if (tail != NULL)
+		alloc = FLINT_MIN(sol_degree, FLINT_MAX(tail->length, 32));
+
+	/* Scratch space: four polynomials, then g_rho and the factors F. The array may move as it grows */
+	while (1)
+	{
+		g_rho = acb_ode_workspace_polys(ws, 4 + degree(ODE) + alloc + 1) + 4;
+		F = g_rho + degree(ODE);
+		nu = frobenius_recurrence(sol, g_rho, F, &finite, ODE, start, alloc, tail, eta, table, offset, ws, prec);
+		if (finite || nu < alloc || alloc == sol_degree)
+			break;
+		start = nu + 1;
+		alloc = FLINT_MIN(2*alloc, sol_degree);
+	}
+	frobenius_finish(sol, sol, F, nu, ws, prec);
+	return nu;
+}
+
+void acb_ode_solve_frobenius_ws (acb_ode_solution_t sol, acb_ode_t ODE, slong sol_degree,
+		acb_ode_workspace_t ws, slong prec)
+{
+	if (sol->M == 1)
+	{
+		acb_ptr temp = acb_ode_workspace_vec(ws, 5);
+		frobenius_rho(temp + 4, ODE, sol, prec);
+		frobenius_single(sol->gens, ODE, temp + 4, sol->gens, 0, sol_degree, temp, prec);
+	}
+	else
+		frobenius_series(sol, ODE, sol_degree, NULL, NULL, NULL, 0, ws, prec);
+}
+
+void acb_ode_solve_frobenius (acb_ode_solution_t sol, acb_ode_t ODE, slong sol_degree, slong prec)
+{
+	acb_ode_workspace_t ws;
+	acb_ode_workspace_init(ws);
+	acb_ode_solve_frobenius_ws(sol, ODE, sol_degree, ws, prec);
+	acb_ode_workspace_clear(ws);
+}
+
+slong acb_ode_solve_frobenius_tail_ws (acb_ode_solution_t sol, mag_t err, acb_ode_t ODE, const mag_t eta,
+		slong max_degree, acb_ode_workspace_t ws, slong prec)
+{
+	/* Solve the homogeneous equation, and bound the tail of the normalized generators */
+	slong deg;
+	acb_ode_tail_t tail;
+
+	acb_ode_plan_set(&ws->plan, ODE);
+	acb_ode_tail_init(tail, &ws->plan, sol->rho, sol->M, prec);
+
+	deg = frobenius_series(sol, ODE, max_degree, tail, eta, NULL, 0, ws, prec);
+	acb_ode_tail_bound(err, tail, sol->gens, deg + 1, eta);
+
+	acb_ode_tail_clear(tail);
+	return deg;
+}
+
+slong acb_ode_solve_frobenius_tail (acb_ode_solution_t sol, mag_t err, acb_ode_t ODE, const mag_t eta,
+		slong max_degree, slong prec)
+{
+	slong deg;
+	acb_ode_workspace_t ws;
+
+	acb_ode_workspace_init(ws);
+	deg = acb_ode_solve_frobenius_tail_ws(sol, err, ODE, eta, max_degree, ws, prec);
+	acb_ode_workspace_clear(ws);
+	return deg;
+}
+
+/* Series which can be extended later */
+
+static void series_init (acb_ode_series_t S, acb_ode_t ODE, acb_t rho, slong mul, slong alpha, slong prec)
+{
+	acb_ode_init_blank(&S->ODE, -1, 0);
+	acb_ode_set(&S->ODE, ODE);
+	acb_ode_plan_init(&S->plan, &S->ODE);
+	acb_ode_workspace_init(&S->ws);
+	acb_ode_solution_init(&S->sol, rho, mul, alpha);
+	acb_ode_solution_init(&S->raw, rho, mul, alpha);
+	S->has_tail = 0;
+	S->finite = 0;
+	S->length = 0;
+	S->alloc = 0;
+	S->g_rho = NULL;
+	S->F = NULL;
+	S->prec = prec;
+}
+
+void acb_ode_series_init_fuchs (acb_ode_series_t S, acb_ode_t ODE, acb_poly_t init, slong prec)
+{
+	acb_t zero;
+	acb_init(zero);
+	series_init(S, ODE, zero, 1, 0, prec);
+	acb_poly_set(S->sol.gens, init);
+	S->fuchs = 1;
+	acb_clear(zero);
+}
+
+void acb_ode_series_init_frobenius (acb_ode_series_t S, acb_ode_t ODE, acb_t rho, slong mul, slong alpha, slong prec)
+{
+	series_init(S, ODE, rho, mul, alpha, prec);
+	S->fuchs = 0;
+	if (S->sol.M > 1)
+	{
+		S->g_rho = flint_malloc(degree(ODE) * sizeof(acb_poly_struct));
+		for (slong i = 0; i < degree(ODE); i++)
+			acb_poly_init(S->g_rho + i);
+	}
+}
+
+void acb_ode_series_clear (acb_ode_series_t S)
+{
+	if (S->g_rho != NULL)
+	{
+		for (slong i = 0; i < degree(&S->ODE); i++)
+			acb_poly_clear(S->g_rho + i);
+		flint_free(S->g_rho);
+	}
+	for (slong n = 0; n < S->alloc; n++)
+		acb_poly_clear(S->F + n);
+	flint_free(S->F);
+
+	if (S->has_tail)
+		acb_ode_tail_clear(&S->tail);
+	acb_ode_solution_clear(&S->sol);
+	acb_ode_solution_clear(&S->raw);
+	acb_ode_workspace_clear(&S->ws);
+	acb_ode_plan_clear(&S->plan);
+	acb_ode_clear(&S->ODE);
+}
+
+static slong series_recurrence (acb_ode_series_t S, slong sol_degree, acb_ode_tail_t tail, const mag_t eta)
+{
+	/* Continue the recurrence up to sol_degree, and return the last index computed */
+	slong nu = sol_degree;
+	acb_ptr temp;
+
+	if (S->fuchs)
+		_acb_ode_solve_fuchs_range(S->sol.gens, &S->plan, S->length, sol_degree, S->prec);
+	else if (S->sol.M == 1)
+	{
+		/* The coefficients are final at once, and the right hand side is zero */
+		temp = acb_ode_workspace_vec(&S->ws, 4);
+		frobenius_single(S->sol.gens, &S->ODE, S->sol.rho, S->raw.gens, S->length, sol_degree, temp, S->prec);
+	}
+	else
+	{
+		if (S->alloc <= sol_degree)
+		{
+			slong alloc = FLINT_MAX(sol_degree + 1, 2*S->alloc);
+			S->F = flint_realloc(S->F, alloc * sizeof(acb_poly_struct));
+			for (slong n = S->alloc; n < alloc; n++)
+				acb_poly_init(S->F + n);
+			S->alloc = alloc;
+		}
+		nu = frobenius_recurrence(&S->raw, S->g_rho, S->F, &S->finite, &S->ODE, S->length, sol_degree,
+				tail, eta, NULL, 0, &S->ws, S->prec);
+	}
+
+	S->length = nu + 1;
+	return nu;
+}
+
+static void series_finish (acb_ode_series_t S)
+{
+	/* Only Frobenius solutions with several generators defer any factors */
+	if (!S->fuchs && S->sol.M > 1)
+		frobenius_finish(&S->sol, &S->raw, S->F, S->length - 1, &S->ws, S->prec);
+}
+
+void acb_ode_series_extend (acb_ode_series_t S, slong sol_degree)
+{
+	if (sol_degree < S->length)
+		return;
+	/* Beyond the end of a finite series, all coefficients are zero */
+	if (S->finite)
+		return;
+	series_recurrence(S, sol_degree, NULL, NULL);
+	series_finish(S);
+}
+
+slong acb_ode_series_extend_tail (mag_t err, acb_ode_series_t S, const mag_t eta, slong max_degree)
+{
+	/* Grow the series by an eighth of its length at a time, until the tail bound at eta is small enough */
+	slong nu = S->length - 1, next;
+	acb_ode_solution_struct *check = (S->fuchs || S->sol.M == 1) ? &S->sol : &S->raw;
+
+	if (!S->has_tail)
+	{
+		acb_ode_tail_init(&S->tail, &S->plan, S->sol.rho, S->sol.M, S->prec);
+		S->has_tail = 1;
+	}
+
+	while (nu < max_degree && !S->finite)
+	{
+		next = FLINT_MAX(FLINT_MAX(nu + 8, nu + nu/8), S->tail.length);
+		next = FLINT_MIN(next, max_degree);
+		nu = series_recurrence(S, next, &S->tail, eta);
+		if (nu < next || acb_ode_tail_check(err, &S->tail, check->gens, nu + 1, eta, S->prec))
+			break;
+	}
+
+	series_finish(S);
+	acb_ode_tail_bound(err, &S->tail, S->sol.gens, S->length, eta);
+	return S->length - 1;
+}
+
+/* Local basis */
+
+void acb_ode_basis_init (acb_ode_basis_t basis)
+{
+	basis->sols = NULL;
+	basis->length = 0;
+}
+
+void acb_ode_basis_clear (acb_ode_basis_t basis)
+{
+	for (slong a = 0; a < basis->length; a++)
+		acb_ode_solution_clear(basis->sols + a);
+	flint_free(basis->sols);
+	basis->sols = NULL;
+	basis->length = 0;
+}
+
+static int integer_difference (slong *k, acb_t x, acb_t y, slong prec)
+{
+	/* Returns 1 if x - y is an integer k, 0 if it is not, and -1 if this can not be decided */
+	int res = 0;
+	fmpz_t n;
+	arb_t t;
+	acb_t d;
+	fmpz_init(n);
+	arb_init(t);
+	acb_init(d);
+
+	acb_sub(d, x, y, prec);
+	if (arb_contains_zero(acb_imagref(d)) && arb_contains_int(acb_realref(d)))
+	{
+		/* The enclosure must not contain a second integer */
+		arb_set_d(t, 0.5);
+		arb_add(t, acb_realref(d), t, prec);
+		arb_floor(t, t, prec);
+		if (!arb_get_unique_fmpz(n, t) || !fmpz_fits_si(n) || !arb_contains_si(acb_realref(d), fmpz_get_si(n)))
+			res = -1;
+		else
+		{
+			*k = fmpz_get_si(n);
+			res = 1;
+		}
+	}
+
+	fmpz_clear(n);
+	arb_clear(t);
+	acb_clear(d);
+	return res;
+}
+
+typedef struct {
+	acb_ode_struct *ODE;
+	acb_ode_solution_struct *sols;
+	slong *group;		/* index of the first exponent of each group */
+	slong *offset;		/* integer distance to the smallest exponent of the group */
+	slong num;		/* number of exponents */
+	slong num_groups;
+	slong sol_degree;
+	slong start;
+	slong step;
+	slong prec;
+} basis_arg_t;
+
+static void basis_groups (basis_arg_t *arg)
+{
+	/* Solve every exponent of a group with the same table, and every group with the same workspace */
+	acb_ode_workspace_t ws;
+	acb_ode_workspace_init(ws);
+	for (slong g = arg->start; g < arg->num_groups; g += arg->step)
+	{
+		slong base = -1, width = 0, len = 0;
+		for (slong a = 0; a < arg->num; a++)
+		{
+			if (arg->group[a] != g)
+				continue;
+			if (arg->offset[a] == 0)
+				base = a;
+			width = FLINT_MAX(width, arg->offset[a]);
+			len = FLINT_MAX(len, arg->sols[a].M);
+		}
+
+		indicial_table_struct table;
+		indicial_table_init(&table, arg->ODE, arg->sols[base].rho, width + arg->sol_degree + 1, len, arg->prec);
+		for (slong a = 0; a < arg->num; a++)
+			if (arg->group[a] == g)
+				frobenius_series(arg->sols + a, arg->ODE, arg->sol_degree, NULL, NULL, &table, arg->offset[a], ws, arg->prec);
+		indicial_table_clear(&table);
+	}
+	acb_ode_workspace_clear(ws);
+}
+
+static void * basis_worker (void *arg_ptr)
+{
+	basis_groups((basis_arg_t*) arg_ptr);
+	flint_cleanup();
+	return NULL;
+}
+
+int acb_ode_local_basis (acb_ode_basis_t basis, acb_ode_t ODE, slong sol_degree, slong prec)
+{
+	/* Find the exponents at the origin, group them by integer differences, and
+	 * solve for the complete basis, one group per thread */
+	int success = 1;
+	slong n, num, num_groups = 0, num_threads, k;
+	slong *mul, *group, *offset;
+	acb_ptr roots;
+	acb_poly_t f;
+	pthread_t *threads;
+	int *created;
+	basis_arg_t *args;
+
+	acb_ode_basis_clear(basis);
+	acb_poly_init(f);
+	indicial_polynomial(f, ODE, 0, 0, prec);
+	n = acb_poly_degree(f);
+	if (n < order(ODE))
+	{
+		/* The origin is not a regular singular point */
+		acb_poly_clear(f);
+		return 0;
+	}
+
+	roots = _acb_vec_init(n);
+	mul = flint_malloc(n * sizeof(slong));
+	group = flint_malloc(n * sizeof(slong));
+	offset = flint_malloc(n * sizeof(slong));
+	num = _acb_ode_find_roots(roots, mul, f, prec);
+
+	/* A cluster may also hold distinct exponents which could not be separated */
+	acb_t s;
+	acb_init(s);
+	for (slong a = 0; a < num && success; a++)
+	{
+		if (mul[a] > 1 && (success = _acb_ode_multiple_root(s, f, roots + a, mul[a], prec)))
+			acb_set(roots + a, s);
+	}
+	acb_clear(s);
+
+	for (slong a = 0; a < num && success; a++)
+	{
+		group[a] = -1;
+		offset[a] = 0;
+		for (slong b = 0; b < a && group[a] < 0; b++)
+		{
+			int res = integer_difference(&k, roots + a, roots + b, prec);
+			if (res < 0)
+				success = 0;
+			else if (res > 0)
+			{
+				group[a] = group[b];
+				offset[a] = offset[b] + k;
+			}
+		}
+		if (group[a] < 0)
+			group[a] = num_groups++;
+	}
+
+	if (success)
+	{
+		/* The exponents of a group are exact integer translates of the smallest one */
+		basis->sols = flint_malloc(num * sizeof(acb_ode_solution_struct));
+		basis->length = num;
+		for (slong g = 0; g < num_groups; g++)
+		{
+			slong base = -1;
+			for (slong a = 0; a < num; a++)
+				if (group[a] == g && (base < 0 || offset[a] < offset[base]))
+					base = a;
+			k = offset[base];
+			for (slong a = 0; a < num; a++)
+				if (group[a] == g)
+					offset[a] -= k;
+			for (slong a = 0; a < num; a++)
+				if (group[a] == g && a != base)
+					acb_add_si(roots + a, roots + base, offset[a], prec);
+		}
+
+		for (slong a = 0; a < num; a++)
+		{
+			slong alpha = 0;
+			for (slong b = 0; b < num; b++)
+				if (group[b] == group[a] && offset[b] > offset[a])
+					alpha += mul[b];
+			acb_ode_solution_init(basis->sols + a, roots + a, mul[a], alpha);
+			sol_degree = FLINT_MAX(sol_degree, offset[a]);
+		}
+
+		num_threads = FLINT_MAX(1, FLINT_MIN(flint_get_num_threads(), num_groups));
+		threads = flint_malloc(num_threads * sizeof(pthread_t));
+		created = flint_malloc(num_threads * sizeof(int));
+		args = flint_malloc(num_threads * sizeof(basis_arg_t));
+		for (slong t = 0; t < num_threads; t++)
+		{
+			args[t].ODE = ODE;
+			args[t].sols = basis->sols;
+			args[t].group = group;
+			args[t].offset = offset;
+			args[t].num = num;
+			args[t].num_groups = num_groups;
+			args[t].sol_degree = sol_degree;
+			args[t].start = t;
+			args[t].step = num_threads;
+			args[t].prec = prec;
+		}
+		/* The calling thread takes the first share of the work, and that of threads which failed to start */
+		for (slong t = 1; t < num_threads; t++)
+			created[t] = (pthread_create(threads + t, NULL, basis_worker, args + t) == 0);
+		basis_groups(args);
+		for (slong t = 1; t < num_threads; t++)
+		{
+			if (created[t])
+				pthread_join(threads[t], NULL);
+			else
+				basis_groups(args + t);
+		}
+
+		flint_free(threads);
+		flint_free(created);
+		flint_free(args);
+	}
 
-	acb_poly_clear(g_new);
-	acb_poly_clear(indicial);
-	for (slong i = 0; i < degree(ODE); i++)
-		acb_poly_clear(g_rho + i);
-	flint_free(g_rho);
-	acb_clear(temp);
+	flint_free(mul);
+	flint_free(group);
+	flint_free(offset);
+	_acb_vec_clear(roots, n);
+	acb_poly_clear(f);
+	return success;
 }
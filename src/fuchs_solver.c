@@ -93,114 +93,777 @@ slong truncation_order (arb_t eta, arb_t alpha, slong bits)
 	return n;
 }
 
-void acb_ode_solve_fuchs (acb_poly_t res, acb_ode_t ODE, slong num_of_coeffs, slong bits)
+static void fuchs_coefficient (acb_t res, acb_ode_plan_t plan, acb_srcptr c, slong first, slong n, acb_ptr temp, slong bits)
+{
+	/* Compute the coefficient of x^n from the previous ones, where c[i] is the coefficient of x^(first+i),
+	 * using temp[0] and temp[1] */
+	acb_zero(temp + 1);
+
+	/* Loop through the known coefficients of the power series */
+	for (slong k = FLINT_MIN(n, plan->length - 1); k > 0; k--)
+	{
+		acb_ode_plan_evaluate(temp, plan, k, n - k, bits);
+		acb_submul(temp + 1, temp, c + (n - k - first), bits);
+	}
+	acb_ode_plan_evaluate(temp, plan, 0, n, bits);
+	acb_div(res, temp + 1, temp, bits);
+}
+
+static slong recurrence_evaluations (slong start, slong end, slong length)
+{
+	/* Number of diagonals evaluated for the coefficients of index start, ..., end-1 */
+	slong count = 0;
+	for (slong n = start; n < end; n++)
+		count += FLINT_MIN(n, length - 1) + 1;
+	return count;
+}
+
+static void fuchs_series (acb_poly_t res, acb_ode_plan_t plan, slong start, slong num_of_coeffs, acb_ptr temp, slong bits)
+{
+	/* Compute the coefficients from start on, the previous ones are known already */
+	slong v = plan->valuation;
+	slong len = FLINT_MAX(acb_poly_length(res), num_of_coeffs + 1);
+	double time = acb_ode_stats_active() ? _acb_ode_stats_clock() : 0;
+
+	start = FLINT_MAX(start, FLINT_MAX(-v, 0));
+	acb_poly_fit_length(res, len);
+	_acb_poly_set_length(res, len);
+	for (slong n = start; n <= num_of_coeffs; n++)
+		fuchs_coefficient(res->coeffs + n, plan, res->coeffs, 0, n, temp, bits);
+	if (acb_ode_stats_active())
+	{
+		_acb_ode_stats_add_time(ACB_ODE_STAGE_RECURRENCE, time);
+		_acb_ode_stats_recurrence(num_of_coeffs + 1 - start,
+				recurrence_evaluations(start, num_of_coeffs + 1, plan->length));
+		_acb_ode_stats_coefficients(res->coeffs, 0, start, num_of_coeffs + 1);
+	}
+	_acb_poly_normalise(res);
+}
+
+void _acb_ode_solve_fuchs (acb_poly_t res, acb_ode_plan_t plan, slong num_of_coeffs, slong bits)
 {
 	/* Iteratively compute the first num_of_coeffs coefficients of the power series solution of the ODE around zero */
-	acb_t temp1; acb_init(temp1);
-	acb_t temp2; acb_init(temp2);
-	acb_t new_coeff; acb_init(new_coeff);
-
-	fmpz_t fac; fmpz_init(fac);
-	slong i_min, i_max;
-	slong v = acb_ode_valuation(ODE);
-
-	acb_poly_fit_length(res, num_of_coeffs);
-	for (slong b_max = -v; b_max <= num_of_coeffs; b_max++)
-	{
-		acb_zero(new_coeff);
-		slong exp = b_max + v;
-		/* Loop through the known coefficients of the power series */
-		slong b_min = clamp(exp - degree(ODE), 0, b_max);
-		acb_set(temp2, acb_ode_coeff(ODE, 0, exp-b_min));
-		slong b = b_min;
-		do {
-			acb_poly_get_coeff_acb(temp1, res, b);
-			acb_mul(temp2, temp1, temp2, bits);
-			acb_sub(new_coeff, new_coeff, temp2, bits);
-
-			acb_zero(temp2);
-			fmpz_one(fac);
-			/* Loop through the polynomials */
-			b++;
-			i_min = clamp(b - exp, 0, -v);
-			i_max = clamp(b - b_min, 0, order(ODE));
-			for (slong i = i_min; i <= i_max; i++)
-			{
-				acb_set(temp1, acb_ode_coeff(ODE, i, i + exp - b));
-				acb_mul_fmpz(temp1, temp1, fac, bits);
-				acb_add(temp2, temp2, temp1, bits);
-				fmpz_mul_si(fac, fac, b-i);
-			}
-			fmpz_rfac_uiui(fac, b-i_min+1, i_min);
-			acb_mul_fmpz(temp2, temp2, fac, bits);
-		} while (b != b_max);
-		acb_div(new_coeff, new_coeff, temp2, bits);
-		acb_poly_set_coeff_acb(res, b_max, new_coeff);
+	_acb_ode_solve_fuchs_range(res, plan, 0, num_of_coeffs, bits);
+}
+
+void _acb_ode_solve_fuchs_range (acb_poly_t res, acb_ode_plan_t plan, slong start, slong num_of_coeffs, slong bits)
+{
+	acb_ptr temp = _acb_vec_init(2);
+	fuchs_series(res, plan, start, num_of_coeffs, temp, bits);
+	_acb_vec_clear(temp, 2);
+}
+
+void acb_ode_solve_fuchs_ws (acb_poly_t res, acb_ode_t ODE, slong num_of_coeffs, acb_ode_workspace_t ws, slong bits)
+{
+	acb_ode_plan_set(&ws->plan, ODE);
+	fuchs_series(res, &ws->plan, 0, num_of_coeffs, acb_ode_workspace_vec(ws, 2), bits);
+}
+
+void acb_ode_solve_fuchs (acb_poly_t res, acb_ode_t ODE, slong num_of_coeffs, slong bits)
+{
+	acb_ode_workspace_t ws;
+	acb_ode_workspace_init(ws);
+	acb_ode_solve_fuchs_ws(res, ODE, num_of_coeffs, ws, bits);
+	acb_ode_workspace_clear(ws);
+}
+
+slong _acb_ode_solve_fuchs_tail (acb_poly_t res, mag_t err, acb_ode_plan_t plan, acb_ode_tail_t tail,
+		const mag_t eta, slong max_coeffs, slong bits)
+{
+	/* Stop as soon as the tail bound at eta is small enough, checking less often for long series */
+	acb_ptr temp = _acb_vec_init(2);
+
+	slong v = plan->valuation;
+	slong len = FLINT_MAX(acb_poly_length(res), max_coeffs + 1);
+	slong n = FLINT_MAX(-v, 0), next = n + tail->length, start = n;
+	int done = 0;
+	double time = acb_ode_stats_active() ? _acb_ode_stats_clock() : 0;
+
+	acb_poly_fit_length(res, len);
+	_acb_poly_set_length(res, len);
+	for (; n <= max_coeffs && !done; n++)
+	{
+		fuchs_coefficient(res->coeffs + n, plan, res->coeffs, 0, n, temp, bits);
+		if (n < next)
+			continue;
+		done = acb_ode_tail_check(err, tail, res, n + 1, eta, bits);
+		next = n + FLINT_MAX(8, n/8);
+	}
+
+	/* Now n coefficients are known */
+	if (!done)
+		acb_ode_tail_bound(err, tail, res, n, eta);
+	if (acb_ode_stats_active())
+	{
+		_acb_ode_stats_add_time(ACB_ODE_STAGE_RECURRENCE, time);
+		_acb_ode_stats_recurrence(n - start, recurrence_evaluations(start, n, plan->length));
+		_acb_ode_stats_coefficients(res->coeffs, 0, start, n);
 	}
+	acb_poly_truncate(res, n);
+	_acb_poly_normalise(res);
+
+	_acb_vec_clear(temp, 2);
+	return n - 1;
+}
+
+slong acb_ode_solve_fuchs_tail_ws (acb_poly_t res, mag_t err, acb_ode_t ODE, const mag_t eta, slong max_coeffs,
+		acb_ode_workspace_t ws, slong bits)
+{
+	slong n;
+	acb_t rho;
+	acb_ode_tail_t tail;
+
+	acb_init(rho);
+	acb_ode_plan_set(&ws->plan, ODE);
+	acb_ode_tail_init(tail, &ws->plan, rho, 1, bits);
+	n = _acb_ode_solve_fuchs_tail(res, err, &ws->plan, tail, eta, max_coeffs, bits);
 
-	acb_clear(new_coeff);
-	acb_clear(temp1);
-	acb_clear(temp2);
-	fmpz_clear(fac);
+	acb_ode_tail_clear(tail);
+	acb_clear(rho);
+	return n;
+}
+
+slong acb_ode_solve_fuchs_tail (acb_poly_t res, mag_t err, acb_ode_t ODE, const mag_t eta, slong max_coeffs, slong bits)
+{
+	slong n;
+	acb_ode_workspace_t ws;
+
+	acb_ode_workspace_init(ws);
+	n = acb_ode_solve_fuchs_tail_ws(res, err, ODE, eta, max_coeffs, ws, bits);
+	acb_ode_workspace_clear(ws);
+	return n;
+}
+
+/* Coefficients one at a time */
+
+void acb_ode_stream_init (acb_ode_stream_t st, acb_ode_plan_t plan, acb_poly_t init, slong bits)
+{
+	/* The window holds twice the number of coefficients the recurrence looks back */
+	st->plan = plan;
+	st->start = FLINT_MAX(-plan->valuation, 0);
+	st->width = FLINT_MAX(FLINT_MAX(plan->length - 1, st->start), 1);
+	st->window = _acb_vec_init(2*st->width + 2);
+	st->temp = st->window + 2*st->width;
+	st->first = 0;
+	st->n = 0;
+	st->bits = bits;
+
+	for (slong j = 0; j < FLINT_MIN(st->start, acb_poly_length(init)); j++)
+		acb_set(st->window + j, init->coeffs + j);
+}
+
+void acb_ode_stream_clear (acb_ode_stream_t st)
+{
+	_acb_vec_clear(st->window, 2*st->width + 2);
+}
+
+void acb_ode_stream_next (acb_t res, acb_ode_stream_t st)
+{
+	slong n = st->n;
+
+	/* Keep only the last width coefficients */
+	if (n - st->first == 2*st->width)
+	{
+		for (slong j = 0; j < st->width; j++)
+			acb_swap(st->window + j, st->window + st->width + j);
+		st->first += st->width;
+	}
+
+	if (n >= st->start)
+	{
+		fuchs_coefficient(st->window + (n - st->first), st->plan, st->window, st->first, n, st->temp, st->bits);
+		if (acb_ode_stats_active())
+		{
+			_acb_ode_stats_recurrence(1, recurrence_evaluations(n, n + 1, st->plan->length));
+			_acb_ode_stats_coefficients(st->window + (n - st->first), n, n, n + 1);
+		}
+	}
+	acb_set(res, st->window + (n - st->first));
+	st->n++;
+}
+
+void _acb_ode_solve_fuchs_evaluate (acb_ptr res, acb_ode_plan_t plan, acb_poly_t init, const acb_t x,
+		slong num_of_coeffs, slong len, slong bits)
+{
+	/* Sum the first len Taylor coefficients at x while the coefficients are produced.
+	 * The coefficient of x^n contributes binom(n, k) x^(n-k) to the k-th one */
+	acb_t c;
+	acb_ptr pw;
+	acb_ode_stream_t st;
+
+	if (len <= 0)
+		return;
+
+	double time = acb_ode_stats_active() ? _acb_ode_stats_clock() : 0;
+	acb_init(c);
+	pw = _acb_vec_init(len);
+	acb_ode_stream_init(st, plan, init, bits);
+
+	_acb_vec_zero(res, len);
+	for (slong n = 0; n <= num_of_coeffs; n++)
+	{
+		/* Pascal's rule: binom(n, k) x^(n-k) = x binom(n-1, k) x^(n-1-k) + binom(n-1, k-1) x^(n-k) */
+		for (slong k = FLINT_MIN(n, len - 1); k > 0; k--)
+		{
+			acb_mul(pw + k, pw + k, x, bits);
+			acb_add(pw + k, pw + k, pw + k - 1, bits);
+		}
+		if (n == 0)
+			acb_one(pw);
+		else
+			acb_mul(pw, pw, x, bits);
+
+		acb_ode_stream_next(c, st);
+		for (slong k = FLINT_MIN(n, len - 1); k >= 0; k--)
+			acb_addmul(res + k, c, pw + k, bits);
+	}
+
+	acb_ode_stream_clear(st);
+	_acb_vec_clear(pw, len);
+	acb_clear(c);
+	if (acb_ode_stats_active())
+		_acb_ode_stats_add_time(ACB_ODE_STAGE_EVALUATION, time);
+}
+
+void acb_ode_solve_fuchs_evaluate (acb_ptr res, acb_ode_t ODE, acb_poly_t init, const acb_t x,
+		slong num_of_coeffs, slong len, slong bits)
+{
+	acb_ode_plan_t plan;
+	acb_ode_plan_init(plan, ODE);
+	_acb_ode_solve_fuchs_evaluate(res, plan, init, x, num_of_coeffs, len, bits);
+	acb_ode_plan_clear(plan);
+}
+
+/* Several solutions at once */
+
+typedef struct {
+	acb_ode_plan_struct *plan;
+	acb_ptr window;		/* rows of num coefficients, of index first, ..., n-1 */
+	acb_ptr temp;
+	slong width;
+	slong start;
+	slong first;
+	slong n;
+	slong num;
+	slong bits;
+} fuchs_block_struct;
+
+static void fuchs_block_init (fuchs_block_struct *st, acb_ode_plan_t plan, slong num, slong bits)
+{
+	/* The caller sets the initial values, row i of the window is the coefficient of x^i */
+	st->plan = plan;
+	st->start = FLINT_MAX(-plan->valuation, 0);
+	st->width = FLINT_MAX(FLINT_MAX(plan->length - 1, st->start), 1);
+	st->window = _acb_vec_init(2*st->width*num);
+	st->temp = _acb_vec_init(1);
+	st->first = 0;
+	st->n = 0;
+	st->num = num;
+	st->bits = bits;
+}
+
+static void fuchs_block_clear (fuchs_block_struct *st)
+{
+	_acb_vec_clear(st->window, 2*st->width*st->num);
+	_acb_vec_clear(st->temp, 1);
+}
+
+static acb_srcptr fuchs_block_next (fuchs_block_struct *st)
+{
+	/* Each value of the recurrence is computed once and applied to all solutions */
+	slong n = st->n, num = st->num;
+	acb_ptr row;
+
+	if (n - st->first == 2*st->width)
+	{
+		_acb_vec_swap(st->window, st->window + st->width*num, st->width*num);
+		st->first += st->width;
+	}
+
+	row = st->window + (n - st->first)*num;
+	if (n >= st->start)
+	{
+		_acb_vec_zero(row, num);
+		for (slong k = FLINT_MIN(n, st->plan->length - 1); k > 0; k--)
+		{
+			acb_srcptr c = st->window + (n - k - st->first)*num;
+			acb_ode_plan_evaluate(st->temp, st->plan, k, n - k, st->bits);
+			for (slong j = 0; j < num; j++)
+				acb_submul(row + j, st->temp, c + j, st->bits);
+		}
+		acb_ode_plan_evaluate(st->temp, st->plan, 0, n, st->bits);
+		for (slong j = 0; j < num; j++)
+			acb_div(row + j, row + j, st->temp, st->bits);
+	}
+	st->n++;
+	return row;
+}
+
+void _acb_ode_solve_fuchs_block (acb_poly_struct *res, slong num, acb_ode_plan_t plan, slong num_of_coeffs, slong bits)
+{
+	/* Same as _acb_ode_solve_fuchs for each of res[0], ..., res[num-1] */
+	fuchs_block_struct st;
+	acb_srcptr row;
+
+	if (num <= 0)
+		return;
+
+	fuchs_block_init(&st, plan, num, bits);
+	for (slong j = 0; j < num; j++)
+	{
+		for (slong i = 0; i < FLINT_MIN(st.start, acb_poly_length(res + j)); i++)
+			acb_set(st.window + i*num + j, res[j].coeffs + i);
+		acb_poly_fit_length(res + j, num_of_coeffs + 1);
+		_acb_poly_set_length(res + j, FLINT_MAX(acb_poly_length(res + j), num_of_coeffs + 1));
+	}
+
+	for (slong n = 0; n <= num_of_coeffs; n++)
+	{
+		row = fuchs_block_next(&st);
+		if (n < st.start)
+			continue;
+		for (slong j = 0; j < num; j++)
+			acb_set(res[j].coeffs + n, row + j);
+	}
+
+	for (slong j = 0; j < num; j++)
+		_acb_poly_normalise(res + j);
+	if (acb_ode_stats_active())
+		_acb_ode_stats_recurrence(num*(num_of_coeffs + 1 - st.start),
+				recurrence_evaluations(st.start, num_of_coeffs + 1, plan->length));
+	fuchs_block_clear(&st);
+}
+
+void acb_ode_solve_fuchs_block (acb_poly_struct *res, slong num, acb_ode_t ODE, slong num_of_coeffs, slong bits)
+{
+	acb_ode_plan_t plan;
+	acb_ode_plan_init(plan, ODE);
+	_acb_ode_solve_fuchs_block(res, num, plan, num_of_coeffs, bits);
+	acb_ode_plan_clear(plan);
+}
+
+void _acb_ode_solve_fuchs_evaluate_block (acb_mat_t res, acb_ode_plan_t plan, const acb_mat_t init, const acb_t x,
+		slong num_of_coeffs, slong bits)
+{
+	/* Column j of init holds the initial values of a solution, and the same column of res
+	 * its first Taylor coefficients at x, summed as in _acb_ode_solve_fuchs_evaluate */
+	slong num = acb_mat_ncols(init), len = acb_mat_nrows(res);
+	acb_ptr pw;
+	acb_srcptr row;
+	fuchs_block_struct st;
+
+	if (len <= 0 || num <= 0)
+		return;
+
+	double time = acb_ode_stats_active() ? _acb_ode_stats_clock() : 0;
+	pw = _acb_vec_init(len);
+	fuchs_block_init(&st, plan, num, bits);
+	for (slong i = 0; i < FLINT_MIN(st.start, acb_mat_nrows(init)); i++)
+		for (slong j = 0; j < num; j++)
+			acb_set(st.window + i*num + j, acb_mat_entry(init, i, j));
+
+	acb_mat_zero(res);
+	for (slong n = 0; n <= num_of_coeffs; n++)
+	{
+		for (slong k = FLINT_MIN(n, len - 1); k > 0; k--)
+		{
+			acb_mul(pw + k, pw + k, x, bits);
+			acb_add(pw + k, pw + k, pw + k - 1, bits);
+		}
+		if (n == 0)
+			acb_one(pw);
+		else
+			acb_mul(pw, pw, x, bits);
+
+		row = fuchs_block_next(&st);
+		for (slong k = FLINT_MIN(n, len - 1); k >= 0; k--)
+			for (slong j = 0; j < num; j++)
+				acb_addmul(acb_mat_entry(res, k, j), row + j, pw + k, bits);
+	}
+
+	if (acb_ode_stats_active())
+	{
+		_acb_ode_stats_add_time(ACB_ODE_STAGE_EVALUATION, time);
+		_acb_ode_stats_recurrence(num*(num_of_coeffs + 1 - st.start),
+				recurrence_evaluations(st.start, num_of_coeffs + 1, plan->length));
+	}
+	fuchs_block_clear(&st);
+	_acb_vec_clear(pw, len);
+}
+
+/* Operator families */
+
+static int plan_is_zero (acb_ode_plan_t plan)
+{
+	for (slong d = 0; d < plan->length; d++)
+		if (plan->top[d] >= 0)
+			return 0;
+	return 1;
+}
+
+static void family_evaluate (acb_poly_t res, acb_ode_plan_struct *plans, slong num, slong v, slong d, slong b, slong bits)
+{
+	/* The value of the recurrence on diagonal d, as a polynomial in e. Diagonals count from the valuation v */
+	acb_poly_fit_length(res, num);
+	for (slong k = 0; k < num; k++)
+		acb_ode_plan_evaluate(res->coeffs + k, plans + k, d + v - plans[k].valuation, b, bits);
+	_acb_poly_set_length(res, num);
+	_acb_poly_normalise(res);
+}
+
+void acb_ode_solve_fuchs_family (acb_poly_struct *res, slong len, acb_ode_family_t F, slong num_of_coeffs, slong bits)
+{
+	/* Run the recurrence on power series in e, truncated to length len.
+	 * The coefficient of x^n is kept as c[n], and copied to res at the end */
+	slong num = FLINT_MIN(F->length, len), v = WORD_MAX, length = 0, start;
+	acb_ode_plan_struct *plans;
+	acb_poly_struct *c;
+	acb_poly_t p, t, sum;
+
+	if (len <= 0 || num_of_coeffs < 0)
+		return;
+
+	plans = flint_malloc(num * sizeof(acb_ode_plan_struct));
+	for (slong k = 0; k < num; k++)
+	{
+		acb_ode_plan_init(plans + k, F->ops + k);
+		if (!plan_is_zero(plans + k))
+			v = FLINT_MIN(v, plans[k].valuation);
+	}
+	if (v == WORD_MAX)
+		v = 0;
+	for (slong k = 0; k < num; k++)
+		if (!plan_is_zero(plans + k))
+			length = FLINT_MAX(length, plans[k].length + plans[k].valuation - v);
+	start = FLINT_MAX(-v, 0);
+
+	acb_poly_init(p);
+	acb_poly_init(t);
+	acb_poly_init(sum);
+	c = flint_malloc((num_of_coeffs + 1) * sizeof(acb_poly_struct));
+	for (slong n = 0; n <= num_of_coeffs; n++)
+		acb_poly_init(c + n);
+
+	for (slong n = 0; n < FLINT_MIN(start, num_of_coeffs + 1); n++)
+		for (slong k = len - 1; k >= 0; k--)
+			if (n < acb_poly_length(res + k))
+				acb_poly_set_coeff_acb(c + n, k, res[k].coeffs + n);
+
+	for (slong n = start; n <= num_of_coeffs; n++)
+	{
+		acb_poly_zero(sum);
+		for (slong d = FLINT_MIN(n, length - 1); d > 0; d--)
+		{
+			family_evaluate(p, plans, num, v, d, n - d, bits);
+			acb_poly_mullow(t, p, c + n - d, len, bits);
+			acb_poly_sub(sum, sum, t, bits);
+		}
+		family_evaluate(p, plans, num, v, 0, n, bits);
+		if (acb_poly_is_zero(p))
+		{
+			acb_poly_fit_length(c + n, len);
+			_acb_vec_indeterminate(c[n].coeffs, len);
+			_acb_poly_set_length(c + n, len);
+		}
+		else
+			acb_poly_div_series(c + n, sum, p, len, bits);
+	}
+	if (acb_ode_stats_active())
+		_acb_ode_stats_recurrence(num_of_coeffs + 1 - start,
+				num*recurrence_evaluations(start, num_of_coeffs + 1, length));
+
+	for (slong k = 0; k < len; k++)
+	{
+		slong res_len = FLINT_MAX(acb_poly_length(res + k), num_of_coeffs + 1);
+		acb_poly_fit_length(res + k, res_len);
+		_acb_poly_set_length(res + k, res_len);
+		for (slong n = 0; n <= num_of_coeffs; n++)
+			acb_poly_get_coeff_acb(res[k].coeffs + n, c + n, k);
+		_acb_poly_normalise(res + k);
+	}
+
+	for (slong n = 0; n <= num_of_coeffs; n++)
+		acb_poly_clear(c + n);
+	flint_free(c);
+	acb_poly_clear(p);
+	acb_poly_clear(t);
+	acb_poly_clear(sum);
+	for (slong k = 0; k < num; k++)
+		acb_ode_plan_clear(plans + k);
+	flint_free(plans);
+}
+
+void acb_ode_family_series_evaluate (acb_poly_t res, const acb_poly_struct *sol, slong len, const acb_t e, slong bits)
+{
+	/* Horner's scheme in e */
+	acb_poly_zero(res);
+	for (slong k = len - 1; k >= 0; k--)
+	{
+		acb_poly_scalar_mul(res, res, e, bits);
+		acb_poly_add(res, res, sol + k, bits);
+	}
+}
+
+void analytic_continuation_ws (acb_poly_t res, acb_ode_t ODE, acb_srcptr path,
+		slong len, slong num_of_coeffs, acb_ode_workspace_t ws, slong bits)
+{
+	/* Evaluate a solution along the given piecewise linear path */
+	acb_ptr temp = acb_ode_workspace_vec(ws, 3);
+	acb_ode_struct *ODE_shift = &ws->ODE;
+	if (len > 0)
+		acb_ode_shift(ODE_shift, ODE, path, bits);
+	for (slong time = 0; time+1 < len; time++)
+	{
+		acb_ode_plan_set(&ws->plan, ODE_shift);
+		fuchs_series(res, &ws->plan, 0, num_of_coeffs, temp, bits);
+		acb_sub(temp + 2, path+time+1, path+time, bits);
+		if (acb_ode_stats_active())
+		{
+			double start = _acb_ode_stats_clock();
+			acb_poly_taylor_shift(res, res, temp + 2, bits);
+			_acb_ode_stats_add_time(ACB_ODE_STAGE_TAYLOR_SHIFT, start);
+			_acb_ode_stats_segment(time, num_of_coeffs + 1, path+time+1, res->coeffs,
+					FLINT_MIN(order(ODE), acb_poly_length(res)));
+		}
+		else
+			acb_poly_taylor_shift(res, res, temp + 2, bits);
+		/* Shift the operator incrementally as well */
+		acb_ode_shift(ODE_shift, ODE_shift, temp + 2, bits);
+	}
 }
 
 void analytic_continuation (acb_poly_t res, acb_ode_t ODE, acb_srcptr path,
 		slong len, slong num_of_coeffs, slong bits)
 {
-	/* Evaluate a solution along the given piecewise linear path */
-	acb_t a; acb_init(a);
+	acb_ode_workspace_t ws;
+	acb_ode_workspace_init(ws);
+	analytic_continuation_ws(res, ODE, path, len, num_of_coeffs, ws, bits);
+	acb_ode_workspace_clear(ws);
+}
+
+static int acb_ode_is_exact (acb_ode_t ODE)
+{
+	for (slong i = 0; i < (order(ODE) + 1)*(degree(ODE) + 1); i++)
+		if (!acb_is_exact(ODE->polys + i))
+			return 0;
+	return 1;
+}
+
+static slong bit_burst_step (acb_poly_t res, acb_ode_t ODE, acb_t h, slong bits)
+{
+	/* Replace the initial values at zero by the initial values at h, and return the number of terms */
+	slong num_of_coeffs;
+	arb_t rad, eta;
+	arb_init(rad);
+	arb_init(eta);
+
+	radius_of_convergence(rad, ODE, 20, bits);
+	acb_abs(eta, h, bits);
+	num_of_coeffs = truncation_order(eta, rad, bits);
+
+	if (num_of_coeffs <= 0)
+	{
+		/* The step leaves the disk of convergence */
+		acb_poly_fit_length(res, order(ODE));
+		_acb_poly_set_length(res, order(ODE));
+		_acb_vec_indeterminate(res->coeffs, order(ODE));
+	}
+	else if (!acb_ode_evaluate_bsplit(res, ODE, h, num_of_coeffs, order(ODE), bits))
+	{
+		/* Only the initial values at h are needed, so the series is never stored */
+		acb_ptr val = _acb_vec_init(order(ODE));
+		acb_ode_solve_fuchs_evaluate(val, ODE, res, h, num_of_coeffs, order(ODE), bits);
+		acb_poly_fit_length(res, order(ODE));
+		_acb_vec_swap(res->coeffs, val, order(ODE));
+		_acb_poly_set_length(res, order(ODE));
+		_acb_poly_normalise(res);
+		_acb_vec_clear(val, order(ODE));
+	}
+
+	arb_clear(rad);
+	arb_clear(eta);
+	return num_of_coeffs;
+}
+
+void analytic_continuation_bit_burst (acb_poly_t res, acb_ode_t ODE, acb_srcptr path, slong len, slong bits)
+{
+	/* Evaluate a solution along the given piecewise linear path, approaching
+	 * every corner through points with an increasing number of bits */
+	acb_t delta, target, h, z;
 	acb_ode_t ODE_shift;
+
+	/* Large enough to shift exact operators exactly by points of at most 2*bits bits */
+	slong exact_prec = (degree(ODE) + 2) * (2*bits + 64);
+	slong steps = 0;
+
+	acb_init(delta);
+	acb_init(target);
+	acb_init(h);
+	acb_init(z);
 	acb_ode_init_blank(ODE_shift, degree(ODE), order(ODE));
+
+	acb_poly_truncate(res, order(ODE));
+	acb_ode_shift(ODE_shift, ODE, path, exact_prec);
+	acb_set(z, path);
 	for (slong time = 0; time+1 < len; time++)
 	{
-		acb_ode_shift(ODE_shift, ODE, path+time, bits);
-		acb_ode_solve_fuchs(res, ODE_shift, num_of_coeffs, bits);
-		acb_sub(a, path+time+1, path+time, bits);
-		acb_poly_taylor_shift(res, res, a, bits);
+		acb_sub(delta, path+time+1, path+time, bits);
+		for (slong w = 16; ; w *= 2)
+		{
+			if (w >= bits || !acb_is_exact(path+time))
+				acb_set(target, path+time+1);
+			else
+			{
+				/* Truncate the remaining distance to w bits */
+				acb_get_mid(h, delta);
+				arf_set_round(arb_midref(acb_realref(h)), arb_midref(acb_realref(h)), w, ARF_RND_DOWN);
+				arf_set_round(arb_midref(acb_imagref(h)), arb_midref(acb_imagref(h)), w, ARF_RND_DOWN);
+				acb_add(target, path+time, h, ARF_PREC_EXACT);
+			}
+
+			acb_sub(h, target, z, ARF_PREC_EXACT);
+			if (!acb_is_zero(h))
+			{
+				slong terms = bit_burst_step(res, ODE_shift, h, bits);
+				if (acb_ode_stats_active())
+					_acb_ode_stats_segment(steps++, terms, target, res->coeffs,
+							FLINT_MIN(order(ODE), acb_poly_length(res)));
+				if (acb_ode_is_exact(ODE_shift) && acb_is_exact(h))
+					acb_ode_shift(ODE_shift, ODE_shift, h, exact_prec);
+				else
+					acb_ode_shift(ODE_shift, ODE_shift, h, bits);
+				acb_set(z, target);
+			}
+			if (acb_equal(target, path+time+1))
+				break;
+		}
 	}
+
 	acb_ode_clear(ODE_shift);
+	acb_clear(delta);
+	acb_clear(target);
+	acb_clear(h);
+	acb_clear(z);
+}
+
+slong _acb_ode_continuation_step (acb_poly_t res, acb_ode_t ODE, const acb_t a, slong max_coeffs,
+		acb_ode_workspace_t ws, slong bits)
+{
+	/* Replace the initial values at zero by those at a, including the truncation error of each */
+	slong deg, r = order(ODE);
+	acb_t rho;
+	mag_t eta;
+	mag_ptr err = flint_malloc(r * sizeof(mag_struct));
+	acb_ode_tail_t tail;
+
+	acb_init(rho);
+	mag_init(eta);
+	for (slong j = 0; j < r; j++)
+		mag_init(err + j);
+
+	acb_get_mag(eta, a);
+	acb_ode_plan_set(&ws->plan, ODE);
+	acb_ode_tail_init(tail, &ws->plan, rho, 1, bits);
+	deg = _acb_ode_solve_fuchs_tail(res, err, &ws->plan, tail, eta, max_coeffs, bits);
+	acb_ode_tail_bound_derivatives(err, tail, res, deg + 1, eta, r);
+
+	if (acb_ode_stats_active())
+	{
+		double start = _acb_ode_stats_clock();
+		acb_poly_taylor_shift(res, res, a, bits);
+		_acb_ode_stats_add_time(ACB_ODE_STAGE_TAYLOR_SHIFT, start);
+	}
+	else
+		acb_poly_taylor_shift(res, res, a, bits);
+
+	acb_poly_truncate(res, r);
+	acb_poly_fit_length(res, r);
+	_acb_poly_set_length(res, r);
+	for (slong j = 0; j < r; j++)
+		acb_add_error_mag(res->coeffs + j, err + j);
+	_acb_poly_normalise(res);
+
+	acb_ode_tail_clear(tail);
+	for (slong j = 0; j < r; j++)
+		mag_clear(err + j);
+	flint_free(err);
+	mag_clear(eta);
+	acb_clear(rho);
+	return deg;
+}
+
+static void analytic_continuation_parallel (acb_poly_t res, acb_ode_shift_cache_t cache, acb_ode_path_t path, slong bits)
+{
+	/* Compute all steps in parallel and apply them at once */
+	slong ord = order(cache->base);
+	acb_mat_t T, y;
+	acb_mat_init(T, ord, ord);
+	acb_mat_init(y, ord, 1);
+
+	_acb_ode_path_transition_matrix(T, cache, path, bits);
+	for (slong j = 0; j < ord; j++)
+		acb_poly_get_coeff_acb(acb_mat_entry(y, j, 0), res, j);
+	acb_mat_mul(y, T, y, bits);
+	acb_poly_zero(res);
+	for (slong j = ord - 1; j >= 0; j--)
+		acb_poly_set_coeff_acb(res, j, acb_mat_entry(y, j, 0));
+
+	acb_mat_clear(T);
+	acb_mat_clear(y);
+}
+
+void _analytic_continuation_path (acb_poly_t res, acb_ode_shift_cache_t cache, acb_ode_path_t path, slong bits)
+{
+	/* Evaluate a solution along a path, using as many coefficients as each step needs */
+	acb_t a;
+	acb_ode_workspace_t ws;
+
+	if (flint_get_num_threads() > 1 && path->length > 2)
+	{
+		analytic_continuation_parallel(res, cache, path, bits);
+		return;
+	}
+
+	/* The number of terms of each step is only an upper bound, the tail bound decides */
+	slong deg;
+	acb_init(a);
+	acb_ode_workspace_init(ws);
+	acb_poly_truncate(res, order(cache->base));
+	for (slong time = 0; time+1 < path->length; time++)
+	{
+		acb_sub(a, path->points+time+1, path->points+time, bits);
+		deg = _acb_ode_continuation_step(res, acb_ode_shift_cache_get(cache, path->points+time), a,
+				path->terms[time], ws, bits);
+		if (acb_ode_stats_active())
+			_acb_ode_stats_segment(time, deg + 1, path->points+time+1, res->coeffs,
+					FLINT_MIN(order(cache->base), acb_poly_length(res)));
+	}
+	acb_poly_truncate(res, order(cache->base));
+	acb_ode_workspace_clear(ws);
 	acb_clear(a);
 }
 
+void analytic_continuation_path (acb_poly_t res, acb_ode_t ODE, acb_ode_path_t path, slong bits)
+{
+	acb_ode_shift_cache_t cache;
+	acb_ode_shift_cache_init(cache, ODE, bits);
+	_analytic_continuation_path(res, cache, path, bits);
+	acb_ode_shift_cache_clear(cache);
+}
+
 void find_monodromy_matrix (acb_mat_t mono, acb_ode_t ODE, slong bits)
 {
-	/* Choose a path for the analytic continuation */
-	arb_t rad_of_conv;
-	arb_init(rad_of_conv);
-	radius_of_convergence(rad_of_conv, ODE, 40, bits);
-	if (arb_is_zero(rad_of_conv))
-		return;
-	if (!arb_is_finite(rad_of_conv))
-		arb_one(rad_of_conv);
+	/* The operators shifted while choosing the path are reused for the continuation */
+	acb_ode_path_t path;
+	acb_ode_shift_cache_t cache;
+	acb_ode_path_init(path);
+	acb_ode_shift_cache_init(cache, ODE, bits);
+
+	if (_acb_ode_path_circle(path, cache, bits))
+		_acb_ode_path_transition_matrix(mono, cache, path, bits);
 	else
-		arb_div_si(rad_of_conv, rad_of_conv, 2, bits);
-	arb_get_mid_arb(rad_of_conv, rad_of_conv);
-
-	/* Now initialize the path to move along and a polynomial to store the power series */
-	slong steps = 256;
-	acb_ptr path = _acb_vec_init(steps+1);
-	acb_poly_t res;
-	acb_poly_init(res);
-	_acb_vec_unit_roots(path, steps, steps, bits);
-	_acb_vec_scalar_mul_arb(path, path, steps, rad_of_conv, bits);
-
-	/* Find the number of coefficients necessary every time
-	 * (I am abusing path+steps for this because I can) */
-	acb_sub(path+steps, path, path+1, bits);
-	acb_abs(acb_realref(path+steps), path+steps, bits);
-	slong num_of_coeffs = truncation_order(acb_realref(path+steps), rad_of_conv, bits);
-	acb_set(path+steps, path);
-	arb_clear(rad_of_conv);
-
-	/* Compute the function along the chosen path */
-	for (slong i = 0; i < order(ODE); i++)
-	{
-		acb_poly_zero(res);
-		acb_poly_set_coeff_si(res, i, 1);
-		analytic_continuation(res, ODE, path, steps+1, num_of_coeffs, bits);
-		_acb_vec_set(acb_mat_entry_ptr(mono, i, 0), acb_poly_get_coeff_ptr(res, 0), order(ODE));
-	}
-	acb_mat_transpose(mono, mono);
-	acb_poly_clear(res);
-	_acb_vec_clear(path, steps+1);
+		acb_mat_indeterminate(mono);
+
+	acb_ode_shift_cache_clear(cache);
+	acb_ode_path_clear(path);
 }
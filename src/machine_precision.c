@@ -0,0 +1,502 @@
+#include <float.h>
+#include <math.h>
+#include "cascade.h"
+
+/* Complex balls with a double midpoint and a double radius. Every radius bounds the rounding
+ * errors of its midpoint as well as the propagated radii, and is rounded upwards by inflation.
+ * The real and imaginary parts are kept in separate arrays. */
+
+#define EPS 0x1p-53		/* unit roundoff */
+#define TINY 0x1p-1000		/* absolute bound for underflow */
+#define MACHINE_PREC 53		/* precision of the ball arithmetic around the machine precision parts */
+
+typedef struct {
+	double *re;
+	double *im;
+	double *rad;
+	slong length;
+} dvec_struct;
+
+static double inflate (double r, slong ops)
+{
+	/* Bound r computed with ops roundings in round to nearest, and the rounding of this bound */
+	return r * (1 + (2*ops + 4)*EPS) + TINY;
+}
+
+static void dvec_init (dvec_struct *v, slong len)
+{
+	v->re = flint_calloc(3*FLINT_MAX(len, 1), sizeof(double));
+	v->im = v->re + FLINT_MAX(len, 1);
+	v->rad = v->im + FLINT_MAX(len, 1);
+	v->length = len;
+}
+
+static void dvec_clear (dvec_struct *v)
+{
+	flint_free(v->re);
+}
+
+static int get_d_exact (const arf_t x, double d)
+{
+	/* Whether d = x, for d obtained by rounding x to nearest */
+	if (arf_is_zero(x))
+		return 1;
+	return arf_bits(x) <= 53 && fabs(d) >= DBL_MIN;
+}
+
+static int dvec_set_acb (dvec_struct *v, slong i, const acb_t x)
+{
+	/* Returns 0 if x does not fit into doubles */
+	double re = arf_get_d(arb_midref(acb_realref(x)), ARF_RND_NEAR);
+	double im = arf_get_d(arb_midref(acb_imagref(x)), ARF_RND_NEAR);
+	double rad = mag_get_d(arb_radref(acb_realref(x))) + mag_get_d(arb_radref(acb_imagref(x)));
+
+	/* Exact conversions need no radius */
+	if (!get_d_exact(arb_midref(acb_realref(x)), re))
+		rad += EPS*fabs(re) + TINY;
+	if (!get_d_exact(arb_midref(acb_imagref(x)), im))
+		rad += EPS*fabs(im) + TINY;
+
+	v->re[i] = re;
+	v->im[i] = im;
+	v->rad[i] = (rad == 0) ? 0 : inflate(rad, 2);
+	return isfinite(re) && isfinite(im) && isfinite(v->rad[i]);
+}
+
+static void dvec_get_acb (acb_t x, const dvec_struct *v, slong i)
+{
+	mag_t err;
+	mag_init(err);
+
+	acb_set_d_d(x, v->re[i], v->im[i]);
+	mag_set_d(err, v->rad[i]);
+	acb_add_error_mag(x, err);
+
+	mag_clear(err);
+}
+
+static int dvec_is_finite (const dvec_struct *v, slong start, slong len)
+{
+	double s = 0;
+	for (slong i = start; i < start + len; i++)
+		s += v->rad[i] + fabs(v->re[i]) + fabs(v->im[i]);
+	return isfinite(s);
+}
+
+/* Ball arithmetic on single entries, the result may alias the arguments */
+
+static void dball_mul (double *zr, double *zi, double *zrad, double ar, double ai, double arad,
+		double br, double bi, double brad)
+{
+	double re = ar*br - ai*bi;
+	double im = ar*bi + ai*br;
+	double err = 2*EPS*(fabs(ar*br) + fabs(ai*bi) + fabs(ar*bi) + fabs(ai*br));
+	double prop = (fabs(ar) + fabs(ai))*brad + (fabs(br) + fabs(bi))*arad + arad*brad;
+
+	*zr = re;
+	*zi = im;
+	*zrad = inflate(err + prop, 12);
+}
+
+static void dball_mul_si (double *zr, double *zi, double *zrad, slong t)
+{
+	/* Integers of up to 53 bits are exact */
+	double d = (double) t;
+	*zr *= d;
+	*zi *= d;
+	*zrad = inflate(fabs(d)*(*zrad) + EPS*(fabs(*zr) + fabs(*zi)), 4);
+}
+
+static void dball_add (double *zr, double *zi, double *zrad, double br, double bi, double brad)
+{
+	*zr += br;
+	*zi += bi;
+	*zrad = inflate(*zrad + brad + EPS*(fabs(*zr) + fabs(*zi)), 4);
+}
+
+static int dball_div (double *zr, double *zi, double *zrad, double ar, double ai, double arad,
+		double br, double bi, double brad)
+{
+	/* With the approximate quotient q, |a/b - q| <= |a - qb| / |b|. Returns 0 if b contains zero.
+	 * b is scaled by a power of two first, so that |b|^2 cannot overflow */
+	double rr, ri, rrad, num, den, d, qr, qi, sr, si;
+	int e;
+
+	if (!(fmax(fabs(br), fabs(bi)) > 0) || !isfinite(br) || !isfinite(bi))
+		return 0;
+	frexp(fmax(fabs(br), fabs(bi)), &e);
+	sr = ldexp(br, -e);
+	si = ldexp(bi, -e);
+	d = sr*sr + si*si;
+	qr = ldexp((ar*sr + ai*si)/d, -e);
+	qi = ldexp((ai*sr - ar*si)/d, -e);
+
+	dball_mul(&rr, &ri, &rrad, qr, qi, 0, br, bi, brad);
+	rr = ar - rr;
+	ri = ai - ri;
+	rrad = inflate(rrad + arad + EPS*(fabs(rr) + fabs(ri)), 4);
+
+	num = inflate(fabs(rr) + fabs(ri) + rrad, 2);
+	den = (ldexp(sqrt(d), e)*(1 - 4*EPS) - brad*(1 + 2*EPS))*(1 - 2*EPS);
+	if (!(den > 0) || !isfinite(den) || !isfinite(num))
+		return 0;
+
+	*zr = qr;
+	*zi = qi;
+	*zrad = inflate(num/den, 1);
+	return 1;
+}
+
+/* Recurrence in machine precision */
+
+typedef struct {
+	dvec_struct diags;	/* the entries of the plan */
+	slong *top;
+	slong order;
+	slong length;
+} dplan_struct;
+
+static int dplan_init (dplan_struct *dp, acb_ode_plan_t plan)
+{
+	int ok = 1;
+	slong size = plan->length * (plan->order + 1);
+
+	dvec_init(&dp->diags, size);
+	for (slong k = 0; k < size && ok; k++)
+		ok = dvec_set_acb(&dp->diags, k, plan->diags + k);
+	dp->top = plan->top;
+	dp->order = plan->order;
+	dp->length = plan->length;
+	return ok;
+}
+
+static void dplan_clear (dplan_struct *dp)
+{
+	dvec_clear(&dp->diags);
+}
+
+static void dplan_evaluate (double *zr, double *zi, double *zrad, dplan_struct *dp, slong d, slong b)
+{
+	/* Same as acb_ode_plan_evaluate */
+	if (d < 0 || d >= dp->length || dp->top[d] < 0)
+	{
+		*zr = *zi = *zrad = 0;
+		return;
+	}
+
+	slong i = dp->top[d], k = d*(dp->order + 1);
+	*zr = dp->diags.re[k + i];
+	*zi = dp->diags.im[k + i];
+	*zrad = dp->diags.rad[k + i];
+	for (i--; i >= 0; i--)
+	{
+		dball_mul_si(zr, zi, zrad, b - i);
+		dball_add(zr, zi, zrad, dp->diags.re[k + i], dp->diags.im[k + i], dp->diags.rad[k + i]);
+	}
+}
+
+static int fuchs_coefficient_d (dvec_struct *c, slong first, slong n, dplan_struct *dp, dvec_struct *p)
+{
+	/* Set the entry n - first of c to the coefficient of x^n, using the values of the diagonals in p */
+	slong K = FLINT_MIN(n, dp->length - 1);
+	double sr = 0, si = 0, err = 0, prop = 0, lr, li, lrad;
+
+	for (slong k = 1; k <= K; k++)
+		dplan_evaluate(p->re + k, p->im + k, p->rad + k, dp, k, n - k);
+
+	/* The dot product of the values of the diagonals with the previous coefficients */
+	for (slong k = 1; k <= K; k++)
+	{
+		double ar = p->re[k], ai = p->im[k], br = c->re[n - k - first], bi = c->im[n - k - first];
+		double x = ar*br, y = ai*bi, z = ar*bi, w = ai*br;
+		sr += x - y;
+		si += z + w;
+		err += fabs(x) + fabs(y) + fabs(z) + fabs(w);
+		prop += (fabs(ar) + fabs(ai))*c->rad[n - k - first] + (fabs(br) + fabs(bi))*p->rad[k]
+			+ p->rad[k]*c->rad[n - k - first];
+	}
+	err = inflate(inflate(err, 4*K)*(2*K + 2)*EPS + prop, 4*K);
+
+	dplan_evaluate(&lr, &li, &lrad, dp, 0, n);
+	return dball_div(c->re + (n - first), c->im + (n - first), c->rad + (n - first), -sr, -si, err, lr, li, lrad);
+}
+
+int _acb_ode_solve_fuchs_d (acb_poly_t res, acb_ode_plan_t plan, slong num_of_coeffs)
+{
+	/* Same as _acb_ode_solve_fuchs in machine precision. Returns 0 if this fails, and res is unchanged */
+	int ok;
+	slong start = FLINT_MAX(-plan->valuation, 0);
+	slong len = FLINT_MAX(acb_poly_length(res), num_of_coeffs + 1);
+	dplan_struct dp;
+	dvec_struct c, p;
+
+	ok = dplan_init(&dp, plan);
+	dvec_init(&c, len);
+	dvec_init(&p, dp.length);
+
+	for (slong n = 0; n < acb_poly_length(res) && ok; n++)
+		ok = dvec_set_acb(&c, n, res->coeffs + n);
+	for (slong n = start; n <= num_of_coeffs && ok; n++)
+		ok = fuchs_coefficient_d(&c, 0, n, &dp, &p);
+	ok = ok && dvec_is_finite(&c, 0, len);
+
+	if (ok)
+	{
+		acb_poly_fit_length(res, len);
+		for (slong n = 0; n < len; n++)
+			dvec_get_acb(res->coeffs + n, &c, n);
+		_acb_poly_set_length(res, len);
+		_acb_poly_normalise(res);
+	}
+
+	dvec_clear(&p);
+	dvec_clear(&c);
+	dplan_clear(&dp);
+	return ok;
+}
+
+int acb_ode_solve_fuchs_d (acb_poly_t res, acb_ode_t ODE, slong num_of_coeffs)
+{
+	int ok;
+	acb_ode_plan_t plan;
+	acb_ode_plan_init(plan, ODE);
+	ok = _acb_ode_solve_fuchs_d(res, plan, num_of_coeffs);
+	acb_ode_plan_clear(plan);
+	return ok;
+}
+
+static int tail_bound_d (mag_ptr err, acb_ode_plan_t plan, const dvec_struct *c, slong first, slong n,
+		const acb_t x, slong len)
+{
+	/* Bound the remainder of the series at x by the majorant of acb_ode_tail_bound_derivatives,
+	 * which only needs the last coefficients in the window. Returns 0 if the bound is infinite */
+	int ok = 1;
+	slong D = FLINT_MAX(plan->length - 1, 0);
+	acb_t rho, t;
+	mag_t eta;
+	acb_poly_t last;
+	acb_ode_tail_t tail;
+
+	acb_init(rho);
+	acb_init(t);
+	mag_init(eta);
+	acb_poly_init(last);
+
+	for (slong k = FLINT_MAX(FLINT_MAX(n - D + 1, first), 0); k <= n; k++)
+	{
+		dvec_get_acb(t, c, k - first);
+		acb_poly_set_coeff_acb(last, k, t);
+	}
+	acb_get_mag(eta, x);
+	acb_ode_tail_init(tail, plan, rho, 1, MACHINE_PREC);
+	acb_ode_tail_bound_derivatives(err, tail, last, n + 1, eta, len);
+	for (slong k = 0; k < len; k++)
+		ok = ok && mag_is_finite(err + k);
+
+	acb_ode_tail_clear(tail);
+	acb_poly_clear(last);
+	mag_clear(eta);
+	acb_clear(rho);
+	acb_clear(t);
+	return ok;
+}
+
+int _acb_ode_solve_fuchs_evaluate_d (acb_ptr res, acb_ode_plan_t plan, acb_poly_t init, const acb_t x,
+		slong num_of_coeffs, slong len)
+{
+	/* Same as _acb_ode_solve_fuchs_evaluate, with a window of coefficients as in acb_ode_stream_t,
+	 * and with the truncation error included */
+	int ok;
+	slong start = FLINT_MAX(-plan->valuation, 0), first = 0;
+	slong width = FLINT_MAX(FLINT_MAX(plan->length - 1, start), 1);
+	double cr, ci, crad;
+	mag_ptr err;
+	dplan_struct dp;
+	dvec_struct c, p, pw, sum, xd;
+
+	if (len <= 0)
+		return 1;
+
+	ok = dplan_init(&dp, plan);
+	dvec_init(&c, 2*width);
+	dvec_init(&p, dp.length);
+	dvec_init(&pw, len);
+	dvec_init(&sum, len);
+	dvec_init(&xd, 1);
+	ok = ok && dvec_set_acb(&xd, 0, x);
+
+	for (slong n = 0; n < FLINT_MIN(start, acb_poly_length(init)) && ok; n++)
+		ok = dvec_set_acb(&c, n, init->coeffs + n);
+
+	for (slong n = 0; n <= num_of_coeffs && ok; n++)
+	{
+		if (n - first == 2*width)
+		{
+			for (slong j = 0; j < width; j++)
+			{
+				c.re[j] = c.re[width + j];
+				c.im[j] = c.im[width + j];
+				c.rad[j] = c.rad[width + j];
+			}
+			first += width;
+		}
+		if (n >= start)
+			ok = fuchs_coefficient_d(&c, first, n, &dp, &p);
+
+		/* binom(n, k) x^(n-k), by Pascal's rule */
+		for (slong k = FLINT_MIN(n, len - 1); k > 0; k--)
+		{
+			dball_mul(pw.re + k, pw.im + k, pw.rad + k, pw.re[k], pw.im[k], pw.rad[k], xd.re[0], xd.im[0], xd.rad[0]);
+			dball_add(pw.re + k, pw.im + k, pw.rad + k, pw.re[k - 1], pw.im[k - 1], pw.rad[k - 1]);
+		}
+		if (n == 0)
+			pw.re[0] = 1;
+		else
+			dball_mul(pw.re, pw.im, pw.rad, pw.re[0], pw.im[0], pw.rad[0], xd.re[0], xd.im[0], xd.rad[0]);
+
+		cr = c.re[n - first];
+		ci = c.im[n - first];
+		crad = c.rad[n - first];
+		for (slong k = FLINT_MIN(n, len - 1); k >= 0; k--)
+		{
+			double tr, ti, trad;
+			dball_mul(&tr, &ti, &trad, cr, ci, crad, pw.re[k], pw.im[k], pw.rad[k]);
+			dball_add(sum.re + k, sum.im + k, sum.rad + k, tr, ti, trad);
+		}
+	}
+	ok = ok && dvec_is_finite(&sum, 0, len);
+
+	/* The coefficients beyond the truncation are not computed, only bounded */
+	err = flint_malloc(len * sizeof(mag_struct));
+	for (slong k = 0; k < len; k++)
+		mag_init(err + k);
+	ok = ok && tail_bound_d(err, plan, &c, first, num_of_coeffs, x, len);
+
+	if (ok)
+		for (slong k = 0; k < len; k++)
+		{
+			dvec_get_acb(res + k, &sum, k);
+			acb_add_error_mag(res + k, err + k);
+		}
+
+	for (slong k = 0; k < len; k++)
+		mag_clear(err + k);
+	flint_free(err);
+	dvec_clear(&xd);
+	dvec_clear(&sum);
+	dvec_clear(&pw);
+	dvec_clear(&p);
+	dvec_clear(&c);
+	dplan_clear(&dp);
+	return ok;
+}
+
+int analytic_continuation_d (acb_poly_t res, acb_ode_t ODE, acb_srcptr path, slong len, slong num_of_coeffs)
+{
+	/* Same as analytic_continuation, but only the initial values are kept after every step.
+	 * res is only written once all steps succeeded, so that the caller can fall back on failure */
+	int ok = 1;
+	slong ord = order(ODE);
+	acb_t h;
+	acb_ptr val;
+	acb_poly_t cur;
+	acb_ode_t ODE_shift;
+	acb_ode_plan_t plan;
+
+	acb_init(h);
+	val = _acb_vec_init(ord);
+	acb_poly_init(cur);
+	acb_ode_init_blank(ODE_shift, degree(ODE), ord);
+	acb_ode_plan_init(plan, ODE);
+
+	if (len > 0)
+		acb_ode_shift(ODE_shift, ODE, path, MACHINE_PREC);
+	acb_poly_set(cur, res);
+	acb_poly_truncate(cur, ord);
+	for (slong time = 0; time+1 < len && ok; time++)
+	{
+		acb_ode_plan_set(plan, ODE_shift);
+		acb_sub(h, path+time+1, path+time, MACHINE_PREC);
+		ok = _acb_ode_solve_fuchs_evaluate_d(val, plan, cur, h, num_of_coeffs, ord);
+		if (ok)
+		{
+			acb_poly_zero(cur);
+			for (slong j = ord - 1; j >= 0; j--)
+				acb_poly_set_coeff_acb(cur, j, val + j);
+		}
+		acb_ode_shift(ODE_shift, ODE_shift, h, MACHINE_PREC);
+	}
+	if (ok)
+		acb_poly_swap(res, cur);
+
+	acb_poly_clear(cur);
+	acb_ode_plan_clear(plan);
+	acb_ode_clear(ODE_shift);
+	_acb_vec_clear(val, ord);
+	acb_clear(h);
+	return ok;
+}
+
+/* Solutions */
+
+int acb_ode_solution_evaluate_d (acb_t res, acb_ode_solution_t sol, const acb_t x)
+{
+	/* The generators are summed by Horner's scheme in machine precision, the logarithms and
+	 * the power of x are computed in ball arithmetic */
+	int ok;
+	slong M = sol->M;
+	dvec_struct g, xd;
+	acb_ptr vals;
+	acb_t t, L;
+
+	dvec_init(&g, 1);
+	dvec_init(&xd, 1);
+	vals = _acb_vec_init(M);
+	ok = dvec_set_acb(&xd, 0, x);
+
+	for (slong i = 0; i < M && ok; i++)
+	{
+		acb_poly_struct *gi = sol->gens + i;
+		double zr = 0, zi = 0, zrad = 0, cr, ci, crad;
+		for (slong n = acb_poly_length(gi) - 1; n >= 0 && ok; n--)
+		{
+			dball_mul(&zr, &zi, &zrad, zr, zi, zrad, xd.re[0], xd.im[0], xd.rad[0]);
+			ok = dvec_set_acb(&g, 0, gi->coeffs + n);
+			cr = g.re[0];
+			ci = g.im[0];
+			crad = g.rad[0];
+			dball_add(&zr, &zi, &zrad, cr, ci, crad);
+		}
+		g.re[0] = zr;
+		g.im[0] = zi;
+		g.rad[0] = zrad;
+		ok = ok && dvec_is_finite(&g, 0, 1);
+		if (ok)
+			dvec_get_acb(vals + i, &g, 0);
+	}
+
+	if (ok)
+	{
+		/* z^rho sum_i binom(M-1, i) g_i(z) log(z)^(M-1-i) */
+		acb_init(t);
+		acb_init(L);
+		acb_log(L, x, MACHINE_PREC);
+		acb_zero(res);
+		for (slong i = 0, binom = 1; i < M; i++)
+		{
+			acb_mul(res, res, L, MACHINE_PREC);
+			acb_mul_si(t, vals + i, binom, MACHINE_PREC);
+			acb_add(res, res, t, MACHINE_PREC);
+			binom = (binom * (M - 1 - i)) / (i + 1);
+		}
+		acb_pow(t, x, sol->rho, MACHINE_PREC);
+		acb_mul(res, res, t, MACHINE_PREC);
+		acb_clear(t);
+		acb_clear(L);
+	}
+
+	_acb_vec_clear(vals, M);
+	dvec_clear(&xd);
+	dvec_clear(&g);
+	return ok;
+}
@@ -0,0 +1,346 @@
+#include "cascade.h"
+
+/* Largest local exponent considered for apparent singularities */
+#define MAX_EXPONENT 4096
+
+/* Finest grid searched for the exact location of a multiple root */
+#define GRID_BITS 64
+
+/* Setup and memory management */
+
+void acb_ode_sing_init (acb_ode_sing_t sing)
+{
+	sing->points = NULL;
+	sing->mul = NULL;
+	sing->type = NULL;
+	sing->length = 0;
+}
+
+void acb_ode_sing_clear (acb_ode_sing_t sing)
+{
+	if (sing->length <= 0)
+		return;
+
+	_acb_vec_clear(sing->points, sing->length);
+	flint_free(sing->mul);
+	flint_free(sing->type);
+	sing->length = 0;
+}
+
+/* Clustering */
+
+slong _acb_ode_cluster_roots (acb_ptr points, slong *mul, slong n, slong prec)
+{
+	/* Merge overlapping enclosures in place, until all clusters are pairwise disjoint */
+	slong len = 0;
+	for (slong k = 0; k < n; k++)
+	{
+		acb_swap(points + len, points + k);
+		mul[len] = 1;
+		len++;
+
+		/* A cluster which has grown may overlap further clusters */
+		slong j = len - 1;
+		for (slong i = 0; i < len; )
+		{
+			if (i == j || !acb_overlaps(points + i, points + j))
+			{
+				i++;
+				continue;
+			}
+			acb_union(points + i, points + i, points + j, prec);
+			mul[i] += mul[j];
+			len--;
+			if (j != len)
+			{
+				acb_swap(points + j, points + len);
+				mul[j] = mul[len];
+				if (i == len)
+					i = j;
+			}
+			j = i;
+			i = 0;
+		}
+	}
+	return len;
+}
+
+static void simple_point (acb_t s, const acb_t z)
+{
+	/* The first point of z on the grids 2^-e Z[i], or its midpoint */
+	fmpz_t n;
+	arf_t t;
+	fmpz_init(n);
+	arf_init(t);
+
+	for (slong e = 0; e <= GRID_BITS; e++)
+	{
+		arf_mul_2exp_si(t, arb_midref(acb_realref(z)), e);
+		arf_get_fmpz(n, t, ARF_RND_NEAR);
+		arb_set_fmpz(acb_realref(s), n);
+		arf_mul_2exp_si(t, arb_midref(acb_imagref(z)), e);
+		arf_get_fmpz(n, t, ARF_RND_NEAR);
+		arb_set_fmpz(acb_imagref(s), n);
+		acb_mul_2exp_si(s, s, -e);
+		if (acb_contains(z, s))
+			break;
+	}
+	if (!acb_contains(z, s))
+		acb_get_mid(s, z);
+
+	arf_clear(t);
+	fmpz_clear(n);
+}
+
+int _acb_ode_multiple_root (acb_t s, const acb_poly_t f, const acb_t z, slong m, slong prec)
+{
+	/* Certify that the m roots of f in z are a single root s. As z contains no further roots,
+	 * it suffices that f and its first m-1 derivatives vanish exactly at some s in z */
+	int multiple = 1;
+	slong len = acb_poly_length(f);
+	acb_ptr P = _acb_vec_init(len);
+
+	simple_point(s, z);
+	_acb_vec_set(P, f->coeffs, len);
+	_acb_poly_taylor_shift(P, s, len, prec);
+	for (slong j = 0; j < m && j < len; j++)
+		multiple &= acb_is_zero(P + j);
+
+	_acb_vec_clear(P, len);
+	return multiple;
+}
+
+slong _acb_ode_find_roots (acb_ptr roots, slong *mul, const acb_poly_t f, slong prec)
+{
+	/* Enclose the roots of f and merge them into disjoint clusters.
+	 * Multiple roots are never isolated, so the precision is increased only twice */
+	slong n = acb_poly_degree(f), isolated;
+	for (slong wp = prec; ; wp *= 2)
+	{
+		isolated = acb_poly_find_roots(roots, f, NULL, 0, wp);
+		if (isolated == n || wp >= 4*prec)
+			break;
+	}
+	return _acb_ode_cluster_roots(roots, mul, n, prec);
+}
+
+/* Static functions */
+
+static int is_irregular (acb_ode_t ODE, acb_t s, slong m, slong prec)
+{
+	/* Fuchs' criterion: P_i must vanish to order m - (order - i) at s */
+	int irregular = 0;
+	acb_ptr P = _acb_vec_init(degree(ODE) + 1);
+
+	for (slong i = 0; i < order(ODE) && !irregular; i++)
+	{
+		slong k = m - order(ODE) + i;
+		if (k <= 0)
+			continue;
+
+		_acb_vec_set(P, acb_ode_poly(ODE, i), degree(ODE) + 1);
+		_acb_poly_taylor_shift(P, s, degree(ODE) + 1, prec);
+		for (slong j = 0; j < k && j <= degree(ODE); j++)
+			irregular |= !acb_contains_zero(P + j);
+	}
+
+	_acb_vec_clear(P, degree(ODE) + 1);
+	return irregular;
+}
+
+static int is_apparent (acb_ode_t ODE, acb_t s, slong m, slong prec)
+{
+	/* Check that the exponents at s are distinct non-negative integers, and
+	 * that the recurrence can be solved for arbitrary initial values */
+	int apparent = 1;
+	slong r = order(ODE), top = -1, count = 0, free = 0;
+	mag_t bound;
+	arf_t B;
+	acb_t t;
+	acb_poly_t Q, ff, term;
+	acb_ode_t ODE_s;
+	acb_ode_plan_t plan;
+
+	acb_ode_init_blank(ODE_s, degree(ODE), order(ODE));
+
+	/* The coefficients below the diagonal vanish at s, but are not exactly zero */
+	acb_ode_shift(ODE_s, ODE, s, prec);
+	ODE_s->valuation = m - r;
+	acb_ode_plan_init(plan, ODE_s);
+	acb_ode_clear(ODE_s);
+	if (plan->length <= 0 || acb_contains_zero(acb_ode_plan_entry(plan, 0, r)))
+	{
+		acb_ode_plan_clear(plan);
+		return 0;
+	}
+
+	mag_init(bound);
+	arf_init(B);
+	acb_init(t);
+	acb_poly_init(Q);
+	acb_poly_init(ff);
+	acb_poly_init(term);
+
+	/* Indicial polynomial in the monomial basis */
+	acb_poly_one(ff);
+	for (slong i = 0; i <= r; i++)
+	{
+		acb_poly_scalar_mul(term, ff, acb_ode_plan_entry(plan, 0, i), prec);
+		acb_poly_add(Q, Q, term, prec);
+
+		acb_poly_zero(term);
+		acb_poly_set_coeff_si(term, 1, 1);
+		acb_poly_set_coeff_si(term, 0, -i);
+		acb_poly_mul(ff, ff, term, prec);
+	}
+	_acb_poly_root_bound_fujiwara(bound, Q->coeffs, r + 1);
+	arf_set_mag(B, bound);
+	if (arf_cmp_si(B, MAX_EXPONENT) > 0)
+		apparent = 0;
+
+	/* Integer roots of the indicial polynomial */
+	if (apparent)
+	{
+		for (slong n = 0; arf_cmp_si(B, n) >= 0; n++)
+		{
+			acb_ode_plan_evaluate(t, plan, 0, n, prec);
+			if (acb_contains_zero(t))
+			{
+				count++;
+				top = n;
+			}
+		}
+		apparent = (count == r);
+	}
+
+	/* Every solution is a power series, if the right hand side vanishes at every exponent */
+	if (apparent)
+	{
+		acb_ptr a = _acb_vec_init((top + 1) * r);
+		acb_ptr rhs = _acb_vec_init(r);
+		for (slong n = 0; n <= top && apparent; n++)
+		{
+			_acb_vec_zero(rhs, r);
+			for (slong d = FLINT_MIN(n, plan->length - 1); d > 0; d--)
+			{
+				acb_ode_plan_evaluate(t, plan, d, n - d, prec);
+				_acb_vec_scalar_submul(rhs, a + (n - d)*r, r, t, prec);
+			}
+
+			acb_ode_plan_evaluate(t, plan, 0, n, prec);
+			if (acb_contains_zero(t))
+			{
+				for (slong j = 0; j < r; j++)
+					apparent &= acb_contains_zero(rhs + j);
+				acb_one(a + n*r + free);
+				free++;
+			}
+			else
+				_acb_vec_scalar_div(a + n*r, rhs, r, t, prec);
+		}
+		_acb_vec_clear(a, (top + 1) * r);
+		_acb_vec_clear(rhs, r);
+	}
+
+	acb_ode_plan_clear(plan);
+	acb_poly_clear(Q);
+	acb_poly_clear(ff);
+	acb_poly_clear(term);
+	acb_clear(t);
+	arf_clear(B);
+	mag_clear(bound);
+	return apparent;
+}
+
+/* Locating singularities */
+
+void acb_ode_singularities (acb_ode_sing_t sing, acb_ode_t ODE, slong prec)
+{
+	/* Enclose the roots of the leading coefficient and classify them */
+	slong n, *mul;
+	acb_ptr roots;
+	acb_t s;
+	acb_poly_t lead;
+
+	acb_ode_sing_clear(sing);
+	acb_poly_init(lead);
+	acb_poly_fit_length(lead, degree(ODE) + 1);
+	_acb_vec_set(lead->coeffs, acb_ode_poly(ODE, order(ODE)), degree(ODE) + 1);
+	_acb_poly_set_length(lead, degree(ODE) + 1);
+	_acb_poly_normalise(lead);
+
+	n = acb_poly_degree(lead);
+	if (n <= 0)
+	{
+		acb_poly_clear(lead);
+		return;
+	}
+
+	roots = _acb_vec_init(n);
+	mul = flint_malloc(n * sizeof(slong));
+	sing->length = _acb_ode_find_roots(roots, mul, lead, prec);
+	sing->points = _acb_vec_init(sing->length);
+	sing->mul = flint_malloc(sing->length * sizeof(slong));
+	sing->type = flint_malloc(sing->length * sizeof(int));
+	_acb_vec_set(sing->points, roots, sing->length);
+
+	/* A cluster may hide several roots of lower multiplicity, which Fuchs' criterion cannot decide */
+	acb_init(s);
+	for (slong k = 0; k < sing->length; k++)
+	{
+		sing->mul[k] = mul[k];
+		if (mul[k] == 1)
+			acb_set(s, sing->points + k);
+		else if (!_acb_ode_multiple_root(s, lead, sing->points + k, mul[k], prec))
+		{
+			sing->type[k] = ACB_ODE_SING_UNKNOWN;
+			continue;
+		}
+
+		if (is_irregular(ODE, s, mul[k], prec))
+			sing->type[k] = ACB_ODE_SING_IRREGULAR;
+		else if (is_apparent(ODE, s, mul[k], prec))
+			sing->type[k] = ACB_ODE_SING_APPARENT;
+		else
+			sing->type[k] = ACB_ODE_SING_REGULAR;
+	}
+	acb_clear(s);
+
+	flint_free(mul);
+	_acb_vec_clear(roots, n);
+	acb_poly_clear(lead);
+}
+
+void _acb_ode_sing_distance (arb_t rad, acb_ode_sing_t sing, acb_t z, slong skip, slong prec)
+{
+	/* Lower bound for the distance from z to all singular points except sing->points[skip] */
+	arb_t dist;
+	acb_t diff;
+	arb_init(dist);
+	acb_init(diff);
+
+	arb_pos_inf(rad);
+	for (slong k = 0; k < sing->length; k++)
+	{
+		if (k == skip)
+			continue;
+		if (acb_contains(sing->points + k, z))
+		{
+			arb_zero(rad);
+			break;
+		}
+		acb_sub(diff, z, sing->points + k, prec);
+		acb_abs(dist, diff, prec);
+		arb_get_lbound_arf(arb_midref(dist), dist, prec);
+		mag_zero(arb_radref(dist));
+		arb_min(rad, rad, dist, prec);
+	}
+
+	arb_clear(dist);
+	acb_clear(diff);
+}
+
+void acb_ode_sing_distance (arb_t rad, acb_ode_sing_t sing, acb_t z, slong prec)
+{
+	_acb_ode_sing_distance(rad, sing, z, -1, prec);
+}
@@ -0,0 +1,156 @@
+#include <pthread.h>
+#include "cascade.h"
+
+void _acb_ode_transition_matrix (acb_mat_t T, acb_ode_t ODE, acb_t h, slong num_of_coeffs, slong bits)
+{
+	/* Map the initial values at zero to the initial values at h, all columns at once */
+	acb_mat_t init;
+	acb_ode_plan_t plan;
+
+	acb_mat_init(init, order(ODE), order(ODE));
+	acb_mat_one(init);
+	acb_ode_plan_init(plan, ODE);
+	_acb_ode_solve_fuchs_evaluate_block(T, plan, init, h, num_of_coeffs, bits);
+
+	acb_ode_plan_clear(plan);
+	acb_mat_clear(init);
+}
+
+void acb_ode_transition_matrix (acb_mat_t T, acb_ode_t ODE, acb_t a, acb_t b, slong num_of_coeffs, slong bits)
+{
+	acb_t h;
+	acb_ode_t ODE_shift;
+
+	acb_init(h);
+	acb_ode_init_blank(ODE_shift, degree(ODE), order(ODE));
+
+	acb_ode_shift(ODE_shift, ODE, a, bits);
+	acb_sub(h, b, a, bits);
+	_acb_ode_transition_matrix(T, ODE_shift, h, num_of_coeffs, bits);
+
+	acb_ode_clear(ODE_shift);
+	acb_clear(h);
+}
+
+/* Parallel evaluation along a path */
+
+typedef struct {
+	acb_ode_struct **shifts;
+	acb_ode_path_struct *path;
+	acb_mat_struct *mats;
+	slong start;
+	slong step;
+	slong bits;
+} transition_arg_t;
+
+static void transition_steps (transition_arg_t *arg)
+{
+	/* Each column is continued like a single solution, stopping at its tail bound */
+	acb_t h;
+	acb_poly_t col;
+	acb_ode_workspace_t ws;
+	acb_ode_path_struct *path = arg->path;
+
+	acb_init(h);
+	acb_poly_init(col);
+	acb_ode_workspace_init(ws);
+	for (slong k = arg->start; k+1 < path->length; k += arg->step)
+	{
+		acb_mat_struct *T = arg->mats + k;
+		acb_sub(h, path->points + k + 1, path->points + k, arg->bits);
+		for (slong j = 0; j < acb_mat_ncols(T); j++)
+		{
+			acb_poly_zero(col);
+			acb_poly_set_coeff_si(col, j, 1);
+			_acb_ode_continuation_step(col, arg->shifts[k], h, path->terms[k], ws, arg->bits);
+			for (slong i = 0; i < acb_mat_nrows(T); i++)
+				acb_poly_get_coeff_acb(acb_mat_entry(T, i, j), col, i);
+		}
+	}
+	acb_ode_workspace_clear(ws);
+	acb_poly_clear(col);
+	acb_clear(h);
+}
+
+static void * transition_worker (void *arg_ptr)
+{
+	transition_steps((transition_arg_t*) arg_ptr);
+	flint_cleanup();
+	return NULL;
+}
+
+void _acb_ode_path_transition_matrix (acb_mat_t T, acb_ode_shift_cache_t cache, acb_ode_path_t path, slong bits)
+{
+	/* Compute the matrices of all steps independently, then multiply them in a balanced tree */
+	slong num = path->length - 1;
+	slong num_threads;
+	int *created;
+	acb_ode_struct **shifts;
+	acb_mat_struct *mats;
+	pthread_t *threads;
+	transition_arg_t *args;
+
+	if (num <= 0)
+	{
+		acb_mat_one(T);
+		return;
+	}
+
+	/* The cache is filled and the valuations are set before the threads only read from it.
+	 * A point visited twice shares its operator between two steps */
+	shifts = flint_malloc(num * sizeof(acb_ode_struct*));
+	mats = flint_malloc(num * sizeof(acb_mat_struct));
+	for (slong k = 0; k < num; k++)
+	{
+		shifts[k] = acb_ode_shift_cache_get(cache, path->points + k);
+		acb_ode_valuation(shifts[k]);
+		acb_mat_init(mats + k, order(cache->base), order(cache->base));
+	}
+
+	num_threads = FLINT_MAX(1, FLINT_MIN(flint_get_num_threads(), num));
+	threads = flint_malloc(num_threads * sizeof(pthread_t));
+	created = flint_malloc(num_threads * sizeof(int));
+	args = flint_malloc(num_threads * sizeof(transition_arg_t));
+	for (slong t = 0; t < num_threads; t++)
+	{
+		args[t].shifts = shifts;
+		args[t].path = path;
+		args[t].mats = mats;
+		args[t].start = t;
+		args[t].step = num_threads;
+		args[t].bits = bits;
+	}
+	/* The calling thread takes the first share of the work, and that of threads which failed to start */
+	for (slong t = 1; t < num_threads; t++)
+		created[t] = (pthread_create(threads + t, NULL, transition_worker, args + t) == 0);
+	transition_steps(args);
+	for (slong t = 1; t < num_threads; t++)
+	{
+		if (created[t])
+			pthread_join(threads[t], NULL);
+		else
+			transition_steps(args + t);
+	}
+
+	/* The later step is multiplied from the left */
+	for (slong width = 1; width < num; width *= 2)
+		for (slong k = 0; k + width < num; k += 2*width)
+			acb_mat_mul(mats + k, mats + k + width, mats + k, bits);
+	acb_mat_set(T, mats);
+
+	for (slong k = 0; k < num; k++)
+		acb_mat_clear(mats + k);
+	flint_free(shifts);
+	flint_free(mats);
+	flint_free(threads);
+	flint_free(created);
+	flint_free(args);
+}
+
+void acb_ode_path_transition_matrix (acb_mat_t T, acb_ode_t ODE, acb_ode_path_t path, slong bits)
+{
+	acb_ode_shift_cache_t cache;
+	acb_ode_shift_cache_init(cache, ODE, bits);
+	_acb_ode_path_transition_matrix(T, cache, path, bits);
+	acb_ode_shift_cache_clear(cache);
+}
@@ -0,0 +1,86 @@
+#include "cascade.h"
+#include <acb_poly.h>
+
+int main ()
+{
+	int return_value = EXIT_SUCCESS;
+
+	slong prec, len;
+
+	flint_rand_t state;
+
+	mag_t res, bound;
+	acb_poly_t in, out, expected, row, deriv;
+	acb_ode_t ODE;
+
+	flint_randinit(state);
+	mag_init(res);
+	mag_init(bound);
+	acb_poly_init(in);
+	acb_poly_init(out);
+	acb_poly_init(expected);
+	acb_poly_init(row);
+	acb_poly_init(deriv);
+
+	for (slong iter = 0; iter < 200; iter++)
+	{
+		prec = 30 + n_randint(state, 128);
+
+		acb_ode_random(ODE, state, prec);
+		acb_poly_randtest(in, state, n_randint(state, 40), prec, 8);
+		len = n_randint(state, 50);
+
+		/* Multiply the full polynomials */
+		acb_poly_zero(expected);
+		acb_poly_set(deriv, in);
+		for (slong i = 0; i <= order(ODE); i++)
+		{
+			acb_poly_zero(row);
+			for (slong j = 0; j <= degree(ODE); j++)
+				acb_poly_set_coeff_acb(row, j, acb_ode_coeff(ODE, i, j));
+			acb_poly_mul(row, row, deriv, prec);
+			acb_poly_add(expected, expected, row, prec);
+			acb_poly_derivative(deriv, deriv, prec);
+		}
+
+		acb_ode_apply(out, ODE, in, prec);
+		if (!acb_poly_overlaps(out, expected))
+		{
+			return_value = EXIT_FAILURE | 0x2;
+			break;
+		}
+
+		acb_poly_set(out, in);
+		acb_ode_apply_trunc(out, ODE, out, len, prec);
+		acb_poly_truncate(expected, len);
+		if (!acb_poly_overlaps(out, expected))
+		{
+			return_value = EXIT_FAILURE | 0x4;
+			break;
+		}
+
+		/* The residual bounds every coefficient */
+		acb_ode_residual(res, ODE, in, len, prec);
+		for (slong j = 0; j < acb_poly_length(expected); j++)
+		{
+			acb_get_mag_lower(bound, expected->coeffs + j);
+			if (mag_cmp(bound, res) > 0)
+				return_value = EXIT_FAILURE | 0x8;
+		}
+
+		acb_ode_clear(ODE);
+		if (return_value != EXIT_SUCCESS)
+			break;
+	}
+
+	acb_poly_clear(in);
+	acb_poly_clear(out);
+	acb_poly_clear(expected);
+	acb_poly_clear(row);
+	acb_poly_clear(deriv);
+	mag_clear(res);
+	mag_clear(bound);
+	flint_randclear(state);
+	flint_cleanup();
+	return return_value;
+}
@@ -0,0 +1,91 @@
+#include "cascade.h"
+#include <acb_poly.h>
+
+int main ()
+{
+	int return_value = EXIT_SUCCESS;
+
+	slong prec;
+
+	flint_rand_t state;
+
+	acb_t c1, c2;
+	acb_ptr path;
+	acb_poly_t direct, result;
+	acb_ode_t ODE;
+
+	flint_randinit(state);
+	acb_init(c1);
+	acb_init(c2);
+	path = _acb_vec_init(3);
+	acb_poly_init(direct);
+	acb_poly_init(result);
+
+	for (slong iter = 0; iter < 50; iter++)
+	{
+		prec = 30 + n_randint(state, 128);
+
+		/* Airy's equation y'' = zy, or y'' = -y */
+		acb_ode_init_blank(ODE, 1, 2);
+		acb_one(acb_ode_coeff(ODE, 2, 0));
+		if (iter % 2)
+			acb_set_si(acb_ode_coeff(ODE, 0, 1), -1);
+		else
+			acb_one(acb_ode_coeff(ODE, 0, 0));
+
+		/* A path to a point with many bits */
+		acb_zero(path);
+		acb_set_si_si(path + 1, n_randint(state, 5) - 2, n_randint(state, 5) - 2);
+		acb_mul_2exp_si(path + 1, path + 1, -2);
+		acb_randtest(path + 2, state, prec, 0);
+		acb_get_mid(path + 2, path + 2);
+		acb_mul_2exp_si(path + 2, path + 2, -1);
+		acb_add(path + 2, path + 2, path + 1, prec);
+		acb_get_mid(path + 2, path + 2);
+
+		acb_poly_zero(result);
+		acb_poly_set_coeff_si(result, 0, 1);
+		acb_poly_set_coeff_si(result, 1, n_randint(state, 3));
+		acb_poly_set(direct, result);
+
+		analytic_continuation_bit_burst(result, ODE, path, 3, prec);
+		analytic_continuation(direct, ODE, path, 3, 30 + prec/2, prec);
+
+		for (slong j = 0; j < order(ODE); j++)
+		{
+			acb_poly_get_coeff_acb(c1, result, j);
+			acb_poly_get_coeff_acb(c2, direct, j);
+			if (!acb_is_finite(c1) || !acb_overlaps(c1, c2))
+			{
+				return_value = EXIT_FAILURE;
+				break;
+			}
+		}
+
+		/* For y'' = -y, compare to the cosine */
+		if (iter % 2 == 0 && return_value == EXIT_SUCCESS)
+		{
+			acb_poly_zero(result);
+			acb_poly_one(result);
+			analytic_continuation_bit_burst(result, ODE, path, 3, prec);
+			acb_cos(c2, path + 2, prec);
+			acb_poly_get_coeff_acb(c1, result, 0);
+			if (!acb_overlaps(c1, c2))
+				return_value = EXIT_FAILURE | 0x2;
+		}
+
+		acb_ode_clear(ODE);
+
+		if (return_value != EXIT_SUCCESS)
+			break;
+	}
+
+	acb_poly_clear(direct);
+	acb_poly_clear(result);
+	_acb_vec_clear(path, 3);
+	acb_clear(c1);
+	acb_clear(c2);
+	flint_randclear(state);
+	flint_cleanup();
+	return return_value;
+}
@@ -0,0 +1,138 @@
+#include "cascade.h"
+#include <acb_poly.h>
+
+int main ()
+{
+	int return_value = EXIT_SUCCESS;
+
+	slong prec, n, len;
+
+	flint_rand_t state;
+
+	acb_t x, c1, c2;
+	fmpq_t q;
+	acb_poly_t series, result;
+	acb_ode_t ODE;
+
+	flint_randinit(state);
+	acb_init(x);
+	acb_init(c1);
+	acb_init(c2);
+	fmpq_init(q);
+	acb_poly_init(series);
+	acb_poly_init(result);
+
+	for (slong iter = 0; iter < 100; iter++)
+	{
+		prec = 30 + n_randint(state, 128);
+
+		if (iter < 50)
+		{
+			/* Legendre's equation at a rational point */
+			acb_ode_legendre(ODE, n_randint(state, 20));
+			fmpq_set_si(q, 1 + n_randint(state, 5), 3 + n_randint(state, 20));
+			acb_set_fmpq(x, q, prec);
+		}
+		else
+		{
+			/* An operator with Gaussian integer coefficients at a dyadic point */
+			acb_ode_init_blank(ODE, 2 + n_randint(state, 4), 1 + n_randint(state, 3));
+			for (slong i = 0; i <= order(ODE); i++)
+				for (slong j = 0; j <= degree(ODE); j++)
+					acb_set_si_si(acb_ode_coeff(ODE, i, j), n_randint(state, 9) - 4, n_randint(state, 9) - 4);
+			acb_set_si_si(acb_ode_coeff(ODE, order(ODE), 0), 8 + n_randint(state, 8), 0);
+			acb_set_si_si(x, n_randint(state, 9) - 4, n_randint(state, 9) - 4);
+			acb_mul_2exp_si(x, x, -4);
+		}
+
+		n = order(ODE) + n_randint(state, 64);
+		len = 1 + n_randint(state, order(ODE) + 1);
+		acb_poly_randtest(series, state, order(ODE), prec, 4);
+		acb_poly_set(result, series);
+
+		if (iter < 50)
+			return_value = acb_ode_evaluate_bsplit_fmpq(result, ODE, q, n, len, prec);
+		else
+			return_value = acb_ode_evaluate_bsplit(result, ODE, x, n, len, prec);
+		if (!return_value)
+		{
+			return_value = EXIT_FAILURE | 0x2;
+			break;
+		}
+		return_value = EXIT_SUCCESS;
+
+		/* Compare to the coefficient-by-coefficient solver */
+		acb_ode_solve_fuchs(series, ODE, n, prec);
+		acb_poly_taylor_shift(series, series, x, prec);
+		for (slong j = 0; j < len; j++)
+		{
+			acb_poly_get_coeff_acb(c1, series, j);
+			acb_poly_get_coeff_acb(c2, result, j);
+			if (!acb_overlaps(c1, c2))
+			{
+				return_value = EXIT_FAILURE | 0x4;
+				break;
+			}
+		}
+
+		acb_ode_clear(ODE);
+
+		if (return_value != EXIT_SUCCESS)
+			break;
+	}
+
+	/* Rational parameters become exact once the denominators are cleared */
+	if (return_value == EXIT_SUCCESS)
+	{
+		fmpq_t a, b, c;
+		acb_t ab, bb, cb;
+		acb_ode_t ODE_ball;
+		fmpq_init(a);
+		fmpq_init(b);
+		fmpq_init(c);
+		acb_init(ab);
+		acb_init(bb);
+		acb_init(cb);
+
+		prec = 64;
+		fmpq_set_si(a, 1, 3);
+		fmpq_set_si(b, -2, 5);
+		fmpq_set_si(c, 3, 7);
+		fmpq_set_si(q, 1, 3);
+		acb_set_fmpq(ab, a, prec);
+		acb_set_fmpq(bb, b, prec);
+		acb_set_fmpq(cb, c, prec);
+		acb_set_fmpq(x, q, prec);
+		acb_ode_hypgeom_fmpq(ODE, a, b, c);
+		acb_ode_hypgeom(ODE_ball, ab, bb, cb, prec);
+
+		acb_poly_one(result);
+		acb_poly_one(series);
+		if (!acb_ode_evaluate_bsplit_fmpq(result, ODE, q, 40, 1, prec))
+			return_value = EXIT_FAILURE | 0x8;
+		acb_ode_solve_fuchs(series, ODE_ball, 40, prec);
+		acb_poly_evaluate(c1, series, x, prec);
+		acb_poly_get_coeff_acb(c2, result, 0);
+		if (!acb_overlaps(c1, c2))
+			return_value = EXIT_FAILURE | 0x8;
+
+		acb_ode_clear(ODE);
+		acb_ode_clear(ODE_ball);
+		fmpq_clear(a);
+		fmpq_clear(b);
+		fmpq_clear(c);
+		acb_clear(ab);
+		acb_clear(bb);
+		acb_clear(cb);
+	}
+
+	acb_poly_clear(series);
+	acb_poly_clear(result);
+	acb_clear(x);
+	acb_clear(c1);
+	acb_clear(c2);
+	fmpq_clear(q);
+	flint_randclear(state);
+	flint_cleanup();
+	return return_value;
+}
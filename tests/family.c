@@ -0,0 +1,122 @@
+#include "cascade.h"
+
+int main ()
+{
+	int return_value = EXIT_SUCCESS;
+
+	slong prec, n, len;
+
+	flint_rand_t state;
+
+	arb_t dist, tol;
+	acb_t nu, e, a, c;
+	acb_poly_struct *res;
+	acb_poly_t ref, val;
+	acb_ode_t ODE, ODE_shift;
+	acb_ode_family_t F, F_shift;
+
+	flint_randinit(state);
+	arb_init(dist);
+	arb_init(tol);
+	acb_init(nu);
+	acb_init(e);
+	acb_init(a);
+	acb_init(c);
+	res = flint_malloc(8 * sizeof(acb_poly_struct));
+	for (slong k = 0; k < 8; k++)
+		acb_poly_init(res + k);
+	acb_poly_init(ref);
+	acb_poly_init(val);
+
+	for (slong iter = 0; iter < 50; iter++)
+	{
+		prec = 64 + n_randint(state, 128);
+		len = 1 + n_randint(state, 8);
+		n = 2*len + n_randint(state, 20);
+
+		/* For y'' + e y = 0, the solution cos(sqrt(e) x) is known termwise */
+		acb_ode_family_init(F, 2, 0, 2);
+		acb_one(acb_ode_coeff(F->ops, 2, 0));
+		acb_one(acb_ode_coeff(F->ops + 1, 0, 0));
+		for (slong k = 0; k < len; k++)
+			acb_poly_zero(res + k);
+		acb_poly_one(res);
+		acb_ode_solve_fuchs_family(res, len, F, n, prec);
+		acb_one(c);
+		for (slong k = 0; k < len; k++)
+		{
+			/* The coefficient of e^k is (-1)^k x^(2k) / (2k)! */
+			acb_poly_zero(ref);
+			acb_poly_set_coeff_acb(ref, 2*k, c);
+			if (!acb_poly_overlaps(res + k, ref))
+				return_value = EXIT_FAILURE | 0x2;
+			acb_div_si(c, c, -(2*k + 1)*(2*k + 2), prec);
+		}
+		acb_ode_family_clear(F);
+
+		/* Bessel's equation away from zero, for an order close to nu */
+		acb_set_si(nu, n_randint(state, 9));
+		acb_div_si(nu, nu, 4, prec);
+		acb_set_si(e, n_randint(state, 2) ? 1 : -1);
+		acb_mul_2exp_si(e, e, -8);
+		acb_set_si(a, 1);
+		acb_ode_family_bessel(F, nu, prec);
+		acb_ode_family_init(F_shift, 3, 2, 2);
+		acb_ode_family_shift(F_shift, F, a, prec);
+
+		acb_add(c, nu, e, prec);
+		acb_ode_bessel(ODE, c, prec);
+		acb_ode_init_blank(ODE_shift, 2, 2);
+		acb_ode_shift(ODE_shift, ODE, a, prec);
+		acb_ode_family_get(ODE, F_shift, e, prec);
+		for (slong i = 0; i <= 2; i++)
+			for (slong j = 0; j <= 2; j++)
+				if (!acb_overlaps(acb_ode_coeff(ODE, i, j), acb_ode_coeff(ODE_shift, i, j)))
+					return_value = EXIT_FAILURE | 0x4;
+
+		for (slong k = 0; k < len; k++)
+			acb_poly_zero(res + k);
+		acb_poly_set_coeff_si(res, 0, 1);
+		acb_poly_set_coeff_si(res, 1, n_randint(state, 3));
+		acb_poly_set(ref, res);
+		acb_ode_solve_fuchs(ref, ODE_shift, n, prec);
+		acb_ode_solve_fuchs_family(res, len, F_shift, n, prec);
+		acb_ode_family_series_evaluate(val, res, len, e, prec);
+
+		/* The truncation in e is not part of the enclosure */
+		for (slong k = 0; k <= n; k++)
+		{
+			acb_poly_get_coeff_acb(c, ref, k);
+			acb_poly_get_coeff_acb(a, val, k);
+			acb_sub(a, a, c, prec);
+			acb_abs(dist, a, prec);
+			acb_abs(tol, c, prec);
+			arb_add_si(tol, tol, 1, prec);
+			arb_mul_2exp_si(tol, tol, 16 - 8*len);
+			if (!arb_contains_zero(dist) && !arb_le(dist, tol))
+				return_value = EXIT_FAILURE | 0x8;
+		}
+
+		acb_ode_clear(ODE);
+		acb_ode_clear(ODE_shift);
+		acb_ode_family_clear(F);
+		acb_ode_family_clear(F_shift);
+		if (return_value != EXIT_SUCCESS)
+			break;
+	}
+
+	for (slong k = 0; k < 8; k++)
+		acb_poly_clear(res + k);
+	flint_free(res);
+	acb_poly_clear(ref);
+	acb_poly_clear(val);
+	arb_clear(dist);
+	arb_clear(tol);
+	acb_clear(nu);
+	acb_clear(e);
+	acb_clear(a);
+	acb_clear(c);
+	flint_randclear(state);
+	flint_cleanup();
+	return return_value;
+}
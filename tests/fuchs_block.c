@@ -0,0 +1,88 @@
+#include "cascade.h"
+
+int main ()
+{
+	int return_value = EXIT_SUCCESS;
+
+	slong prec, n, num, len;
+
+	flint_rand_t state;
+
+	acb_t x;
+	acb_ptr val;
+	acb_poly_struct *res;
+	acb_poly_t ref;
+	acb_mat_t init, T;
+	acb_ode_t ODE;
+	acb_ode_plan_t plan;
+
+	flint_randinit(state);
+	acb_init(x);
+	val = _acb_vec_init(6);
+	res = flint_malloc(5 * sizeof(acb_poly_struct));
+	for (slong j = 0; j < 5; j++)
+		acb_poly_init(res + j);
+	acb_poly_init(ref);
+
+	for (slong iter = 0; iter < 100; iter++)
+	{
+		prec = 30 + n_randint(state, 128);
+		num = 1 + n_randint(state, 5);
+
+		/* Every column is exactly the series of the single solver */
+		acb_ode_random(ODE, state, prec);
+		n = order(ODE) + n_randint(state, 60);
+		acb_mat_init(init, order(ODE), num);
+		acb_mat_randtest(init, state, prec, 4);
+		for (slong j = 0; j < num; j++)
+		{
+			acb_poly_zero(res + j);
+			for (slong i = order(ODE) - 1; i >= 0; i--)
+				acb_poly_set_coeff_acb(res + j, i, acb_mat_entry(init, i, j));
+		}
+		acb_ode_solve_fuchs_block(res, num, ODE, n, prec);
+		for (slong j = 0; j < num; j++)
+		{
+			acb_poly_zero(ref);
+			for (slong i = order(ODE) - 1; i >= 0; i--)
+				acb_poly_set_coeff_acb(ref, i, acb_mat_entry(init, i, j));
+			acb_ode_solve_fuchs(ref, ODE, n, prec);
+			if (!acb_poly_equal(res + j, ref))
+				return_value = EXIT_FAILURE | 0x2;
+		}
+
+		/* The same holds for the Taylor coefficients at a point */
+		len = 1 + n_randint(state, 6);
+		acb_mat_init(T, len, num);
+		acb_randtest(x, state, prec, 2);
+		acb_ode_plan_init(plan, ODE);
+		_acb_ode_solve_fuchs_evaluate_block(T, plan, init, x, n, prec);
+		for (slong j = 0; j < num; j++)
+		{
+			acb_poly_zero(ref);
+			for (slong i = order(ODE) - 1; i >= 0; i--)
+				acb_poly_set_coeff_acb(ref, i, acb_mat_entry(init, i, j));
+			_acb_ode_solve_fuchs_evaluate(val, plan, ref, x, n, len, prec);
+			for (slong k = 0; k < len; k++)
+				if (!acb_equal(val + k, acb_mat_entry(T, k, j)))
+					return_value = EXIT_FAILURE | 0x4;
+		}
+
+		acb_ode_plan_clear(plan);
+		acb_mat_clear(T);
+		acb_mat_clear(init);
+		acb_ode_clear(ODE);
+		if (return_value != EXIT_SUCCESS)
+			break;
+	}
+
+	for (slong j = 0; j < 5; j++)
+		acb_poly_clear(res + j);
+	flint_free(res);
+	acb_poly_clear(ref);
+	acb_clear(x);
+	_acb_vec_clear(val, 6);
+	flint_randclear(state);
+	flint_cleanup();
+	return return_value;
+}
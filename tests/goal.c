@@ -0,0 +1,128 @@
+#include "cascade.h"
+
+static int accurate (acb_poly_t p, slong goal)
+{
+	for (slong i = 0; i < acb_poly_length(p); i++)
+		if (!acb_is_zero(p->coeffs + i) && acb_rel_accuracy_bits(p->coeffs + i) < goal)
+			return 0;
+	return 1;
+}
+
+static int nearly_equal (acb_t x, acb_t y, slong prec)
+{
+	int res;
+	arb_t dist, tol;
+	acb_t diff;
+	arb_init(dist);
+	arb_init(tol);
+	acb_init(diff);
+
+	acb_sub(diff, x, y, prec);
+	acb_abs(dist, diff, prec);
+	acb_abs(tol, y, prec);
+	arb_add_si(tol, tol, 1, prec);
+	arb_mul_2exp_si(tol, tol, 16 - prec);
+	res = acb_overlaps(x, y) || arb_le(dist, tol);
+
+	arb_clear(dist);
+	arb_clear(tol);
+	acb_clear(diff);
+	return res;
+}
+
+int main ()
+{
+	int return_value = EXIT_SUCCESS;
+
+	slong goal, n;
+
+	flint_rand_t state;
+
+	acb_t nu, nu2;
+	acb_ptr corners;
+	acb_poly_t res, expected;
+	acb_ode_t ODE;
+	acb_ode_path_t path;
+	acb_ode_solution_t sol;
+
+	flint_randinit(state);
+	acb_init(nu);
+	acb_init(nu2);
+	corners = _acb_vec_init(3);
+	acb_poly_init(res);
+	acb_poly_init(expected);
+	acb_ode_path_init(path);
+
+	for (slong iter = 0; iter < 20; iter++)
+	{
+		goal = 16 + n_randint(state, 12);
+		n = 2 + n_randint(state, 30);
+
+		/* Power series solution around a regular point */
+		acb_ode_legendre(ODE, 1 + n_randint(state, 10));
+		acb_poly_zero(res);
+		acb_poly_set_coeff_si(res, 0, 1);
+		acb_poly_set_coeff_si(res, 1, n_randint(state, 3));
+		acb_poly_set(expected, res);
+
+		if (!acb_ode_solve_fuchs_goal(res, ODE, n, goal) || !accurate(res, goal))
+			return_value = EXIT_FAILURE | 0x2;
+		acb_ode_solve_fuchs(expected, ODE, n, goal + 16);
+		if (!acb_poly_overlaps(res, expected))
+			return_value = EXIT_FAILURE | 0x4;
+
+		/* Analytic continuation towards the singularity at 1 */
+		acb_zero(corners);
+		acb_set_d_d(corners + 1, 0.5, 0.5);
+		acb_set_d(corners + 2, 0.75);
+		acb_poly_zero(res);
+		acb_poly_set_coeff_si(res, 0, 1);
+		acb_poly_set(expected, res);
+
+		if (!analytic_continuation_goal(res, ODE, corners, 3, goal) || !accurate(res, goal))
+			return_value = EXIT_FAILURE | 0x8;
+		acb_ode_path_adaptive(path, ODE, corners, 3, goal + 16);
+		analytic_continuation_path(expected, ODE, path, goal + 16);
+		/* Both results enclose the true values */
+		for (slong i = 0; i < order(ODE); i++)
+			if (!nearly_equal(res->coeffs + i, expected->coeffs + i, goal)
+					|| !acb_overlaps(res->coeffs + i, expected->coeffs + i))
+				return_value = EXIT_FAILURE | 0x10;
+
+		acb_ode_clear(ODE);
+		if (return_value != EXIT_SUCCESS)
+			break;
+
+		/* Bessel's equation has exponents +nu and -nu at the origin */
+		acb_set_si(nu, 1 + n_randint(state, 15));
+		acb_div_si(nu, nu, 16, goal + 16);
+		acb_set(nu2, nu);
+		acb_ode_bessel(ODE, nu2, goal + 16);
+
+		acb_ode_solution_init(sol, nu, 1, 0);
+		if (!acb_ode_solve_frobenius_goal(sol, ODE, n, goal) || !accurate(sol->gens, goal))
+			return_value = EXIT_FAILURE | 0x20;
+		acb_poly_set(res, sol->gens);
+		acb_ode_solution_clear(sol);
+
+		acb_ode_solution_init(sol, nu, 1, 0);
+		acb_ode_solve_frobenius(sol, ODE, n, goal + 16);
+		if (!acb_poly_overlaps(res, sol->gens))
+			return_value = EXIT_FAILURE | 0x40;
+		acb_ode_solution_clear(sol);
+
+		acb_ode_clear(ODE);
+		if (return_value != EXIT_SUCCESS)
+			break;
+	}
+
+	acb_ode_path_clear(path);
+	acb_poly_clear(res);
+	acb_poly_clear(expected);
+	_acb_vec_clear(corners, 3);
+	acb_clear(nu);
+	acb_clear(nu2);
+	flint_randclear(state);
+	flint_cleanup();
+	return return_value;
+}
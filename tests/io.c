@@ -0,0 +1,116 @@
+#include <stdint.h>
+#include "acb_ode.h"
+
+int main ()
+{
+	int return_value = EXIT_SUCCESS;
+	slong prec;
+	const char *name = "io_test.bin";
+
+	flint_rand_t state;
+
+	acb_t rho, c;
+	acb_ode_t ODE, copy;
+	acb_ode_solution_t sol, res;
+	acb_ode_file_t f;
+
+	flint_randinit(state);
+	acb_init(rho);
+	acb_init(c);
+
+	for (slong iter = 0; iter < 100; iter++)
+	{
+		prec = 30 + n_randint(state, 300);
+
+		/* Operators, including infinite radii */
+		acb_ode_random(ODE, state, prec);
+		if (n_randint(state, 4) == 0)
+			mag_inf(arb_radref(acb_realref(acb_ode_coeff(ODE, 0, 0))));
+		if (!acb_ode_write(ODE, name) || !acb_ode_read(copy, name))
+			return_value = EXIT_FAILURE | 0x2;
+		else
+		{
+			if (order(copy) != order(ODE) || degree(copy) != degree(ODE))
+				return_value = EXIT_FAILURE | 0x4;
+			for (slong i = 0; i <= order(ODE) && return_value == EXIT_SUCCESS; i++)
+				for (slong j = 0; j <= degree(ODE); j++)
+					if (!acb_equal(acb_ode_coeff(copy, i, j), acb_ode_coeff(ODE, i, j)))
+						return_value = EXIT_FAILURE | 0x4;
+			acb_ode_clear(copy);
+		}
+		acb_ode_clear(ODE);
+
+		/* Solutions, read back completely or coefficient by coefficient */
+		acb_randtest(rho, state, prec, 16);
+		acb_ode_solution_init(sol, rho, 1 + n_randint(state, 3), n_randint(state, 3));
+		for (slong i = 0; i < sol->M; i++)
+			acb_poly_randtest(sol->gens + i, state, n_randint(state, 100), prec, 32);
+		if (!acb_ode_solution_write(sol, name) || !acb_ode_solution_read(res, name))
+			return_value = EXIT_FAILURE | 0x8;
+		else
+		{
+			if (res->M != sol->M || res->mul != sol->mul || !acb_equal(res->rho, sol->rho))
+				return_value = EXIT_FAILURE | 0x10;
+			for (slong i = 0; i < sol->M && return_value == EXIT_SUCCESS; i++)
+				if (!acb_poly_equal(res->gens + i, sol->gens + i))
+					return_value = EXIT_FAILURE | 0x10;
+			acb_ode_solution_clear(res);
+		}
+
+		if (!acb_ode_file_open(f, name) || f->kind != ACB_ODE_FILE_SOLUTION)
+			return_value = EXIT_FAILURE | 0x20;
+		else
+		{
+			for (slong i = 0; i < sol->M; i++)
+			{
+				slong n = n_randint(state, acb_poly_length(sol->gens + i) + 1);
+				acb_poly_get_coeff_acb(rho, sol->gens + i, n);
+				acb_ode_file_get(c, f, i + 1, n);
+				if (acb_ode_file_length(f, i + 1) != acb_poly_length(sol->gens + i) || !acb_equal(c, rho))
+					return_value = EXIT_FAILURE | 0x40;
+			}
+			acb_ode_file_close(f);
+		}
+		acb_ode_solution_clear(sol);
+
+		if (return_value != EXIT_SUCCESS)
+			break;
+	}
+
+	/* Operators without coefficients */
+	for (slong k = 0; k < 2; k++)
+	{
+		acb_ode_init_blank(ODE, k - 1, 1 - k);
+		if (!acb_ode_write(ODE, name) || !acb_ode_read(copy, name)
+				|| order(copy) != order(ODE) || degree(copy) != degree(ODE))
+			return_value = EXIT_FAILURE | 0x80;
+		else
+			acb_ode_clear(copy);
+		acb_ode_clear(ODE);
+	}
+
+	/* Dimensions whose product overflows to the number of coefficients are rejected */
+	FILE *out;
+	int64_t dims[2] = {WORD(4611686018427387914), WORD(7127151119387781306)};
+	acb_ode_legendre(ODE, 3);
+	acb_ode_write(ODE, name);
+	out = fopen(name, "r+b");
+	if (out == NULL || fseek(out, 24, SEEK_SET) != 0 || fwrite(dims, sizeof(int64_t), 2, out) != 2
+			|| fclose(out) != 0 || acb_ode_read(copy, name))
+		return_value = EXIT_FAILURE | 0x80;
+	acb_ode_clear(ODE);
+
+	/* Files of another kind are rejected */
+	acb_ode_legendre(ODE, 3);
+	acb_ode_write(ODE, name);
+	if (acb_ode_solution_read(sol, name))
+		return_value = EXIT_FAILURE | 0x80;
+	acb_ode_clear(ODE);
+	remove(name);
+
+	acb_clear(rho);
+	acb_clear(c);
+	flint_randclear(state);
+	flint_cleanup();
+	return return_value;
+}
@@ -0,0 +1,79 @@
+#include "cascade.h"
+
+int main ()
+{
+	int return_value = EXIT_SUCCESS;
+	slong prec, n, total;
+
+	flint_rand_t state;
+	acb_ode_t ODE;
+	acb_t nu, nu2;
+	acb_ode_basis_t basis;
+	acb_ode_solution_t sol;
+
+	flint_randinit(state);
+	acb_init(nu);
+	acb_init(nu2);
+	acb_ode_basis_init(basis);
+
+	for (slong iter = 0; iter < 40; iter++)
+	{
+		prec = 30 + n_randint(state, 32);
+		n = 64 + n_randint(state, 30);
+		flint_set_num_threads(1 + n_randint(state, 3));
+
+		/* Bessel's equation has exponents +nu and -nu, which differ by an integer if 2nu does */
+		acb_set_si(nu, n_randint(state, 32));
+		acb_div_si(nu, nu, 1 << n_randint(state, 4), prec);
+		acb_set(nu2, nu);
+		acb_ode_bessel(ODE, nu2, prec);
+
+		if (!acb_ode_local_basis(basis, ODE, n, prec))
+		{
+			return_value = EXIT_FAILURE | 0x2;
+			break;
+		}
+
+		/* Every exponent is counted with its multiplicity */
+		total = 0;
+		for (slong a = 0; a < basis->length; a++)
+			total += basis->sols[a].mul;
+		if (total != order(ODE))
+			return_value = EXIT_FAILURE | 0x4;
+
+		/* The shared recurrence gives the same series as solving each exponent on its own */
+		for (slong a = 0; a < basis->length; a++)
+		{
+			acb_ode_solution_struct *b = basis->sols + a;
+			acb_ode_solution_init(sol, b->rho, b->mul, b->M - b->mul);
+			acb_ode_solve_frobenius(sol, ODE, n, prec);
+			for (slong i = 0; i < sol->M; i++)
+				if (!acb_poly_overlaps(sol->gens + i, b->gens + i))
+					return_value = EXIT_FAILURE | 0x8;
+			acb_ode_solution_clear(sol);
+		}
+
+		acb_ode_clear(ODE);
+		if (return_value != EXIT_SUCCESS)
+			break;
+	}
+
+	/* z^2 y'' + (1 - 2^-400) z y' = 0 has the distinct exponents 0 and 2^-400, which do not separate */
+	acb_ode_init_blank(ODE, 2, 2);
+	acb_one(acb_ode_coeff(ODE, 2, 2));
+	acb_one(acb_ode_coeff(ODE, 1, 1));
+	acb_one(nu);
+	acb_mul_2exp_si(nu, nu, -400);
+	acb_sub(acb_ode_coeff(ODE, 1, 1), acb_ode_coeff(ODE, 1, 1), nu, 512);
+	if (acb_ode_local_basis(basis, ODE, 32, 64))
+		return_value = EXIT_FAILURE | 0x10;
+	acb_ode_clear(ODE);
+
+	acb_ode_basis_clear(basis);
+	acb_clear(nu);
+	acb_clear(nu2);
+	flint_set_num_threads(1);
+	flint_randclear(state);
+	flint_cleanup();
+	return return_value;
+}
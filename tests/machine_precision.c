@@ -0,0 +1,128 @@
+#include "cascade.h"
+
+int main ()
+{
+	int return_value = EXIT_SUCCESS;
+
+	slong n, ord;
+
+	flint_rand_t state;
+
+	acb_t x, y;
+	acb_ptr path, val;
+	acb_poly_t ref, res;
+	acb_ode_t ODE;
+	acb_ode_plan_t plan;
+	acb_ode_solution_t sol;
+
+	flint_randinit(state);
+	acb_init(x);
+	acb_init(y);
+	path = _acb_vec_init(3);
+	val = _acb_vec_init(4);
+	acb_poly_init(ref);
+	acb_poly_init(res);
+
+	for (slong iter = 0; iter < 100; iter++)
+	{
+		n = 10 + n_randint(state, 60);
+
+		/* The certified results in machine precision contain the ones at higher precision */
+		acb_ode_legendre(ODE, n_randint(state, 10));
+		acb_poly_zero(ref);
+		acb_poly_set_coeff_si(ref, 0, 1);
+		acb_poly_set_coeff_si(ref, 1, n_randint(state, 3));
+		acb_poly_set(res, ref);
+		acb_ode_solve_fuchs(ref, ODE, n, 128);
+		if (!acb_ode_solve_fuchs_d(res, ODE, n) || !acb_poly_overlaps(res, ref)
+			|| acb_poly_length(res) > n + 1)
+			return_value = EXIT_FAILURE | 0x2;
+		for (slong k = 0; k < acb_poly_length(res); k++)
+			if (!acb_is_zero(ref->coeffs + k) && acb_rel_accuracy_bits(res->coeffs + k) < 30)
+				return_value = EXIT_FAILURE | 0x2;
+
+		/* Fused evaluation, and continuation along a path inside the disk of convergence.
+		 * The references have enough terms for their truncation error to be negligible */
+		ord = order(ODE);
+		acb_set_si(x, n_randint(state, 9) - 4);
+		acb_div_si(x, x, 10, 128);
+		acb_poly_truncate(res, ord);
+		acb_ode_plan_init(plan, ODE);
+		acb_poly_set(ref, res);
+		acb_ode_solve_fuchs(ref, ODE, 4*n + 100, 128);
+		acb_poly_taylor_shift(ref, ref, x, 128);
+		if (!_acb_ode_solve_fuchs_evaluate_d(val, plan, res, x, n, ord))
+			return_value = EXIT_FAILURE | 0x4;
+		for (slong k = 0; k < ord; k++)
+		{
+			acb_poly_get_coeff_acb(y, ref, k);
+			if (!acb_overlaps(y, val + k))
+				return_value = EXIT_FAILURE | 0x4;
+		}
+		acb_ode_plan_clear(plan);
+
+		acb_zero(path);
+		acb_set_d_d(path + 1, 0.2, 0.1 * n_randint(state, 3));
+		acb_set_d_d(path + 2, 0.3, 0);
+		acb_poly_set(ref, res);
+		analytic_continuation(ref, ODE, path, 3, 4*n + 100, 128);
+		acb_poly_truncate(ref, ord);
+		if (!analytic_continuation_d(res, ODE, path, 3, 2*n) || !acb_poly_overlaps(res, ref))
+			return_value = EXIT_FAILURE | 0x8;
+		acb_ode_clear(ODE);
+
+		/* Frobenius solutions of Bessel's equation */
+		acb_set_si(x, 1 + n_randint(state, 7));
+		acb_div_si(x, x, 16, 128);
+		acb_set(y, x);
+		acb_ode_bessel(ODE, y, 128);
+		acb_ode_solution_init(sol, x, 1, 0);
+		acb_ode_solve_frobenius(sol, ODE, n, 128);
+		acb_set_d_d(x, 0.5, 0.25 * n_randint(state, 4));
+		acb_ode_solution_evaluate(y, sol, x, 128);
+		if (!acb_ode_solution_evaluate_d(val, sol, x) || !acb_overlaps(y, val) || acb_rel_accuracy_bits(val) < 30)
+			return_value = EXIT_FAILURE | 0x10;
+		acb_ode_solution_clear(sol);
+		acb_ode_clear(ODE);
+
+		if (return_value != EXIT_SUCCESS)
+			break;
+	}
+
+	/* Operators with coefficients beyond the range of doubles are refused */
+	acb_ode_legendre(ODE, 3);
+	arb_set_str(acb_realref(acb_ode_coeff(ODE, 0, 0)), "1e400", 128);
+	acb_poly_one(res);
+	if (acb_ode_solve_fuchs_d(res, ODE, 10) || !acb_poly_is_one(res))
+		return_value = EXIT_FAILURE | 0x20;
+	acb_poly_set_coeff_si(res, 5, 2);
+	acb_poly_set(ref, res);
+	if (analytic_continuation_d(res, ODE, path, 3, 10) || !acb_poly_equal(res, ref))
+		return_value = EXIT_FAILURE | 0x20;
+	acb_ode_clear(ODE);
+
+	/* Scaling the operator leaves the solutions unchanged, even when |b|^2 overflows in a division */
+	acb_ode_legendre(ODE, 3);
+	acb_zero(x);
+	arb_set_str(acb_realref(x), "1e160", 128);
+	for (slong i = 0; i <= order(ODE); i++)
+		_acb_vec_scalar_mul(acb_ode_poly(ODE, i), acb_ode_poly(ODE, i), degree(ODE) + 1, x, 128);
+	acb_poly_zero(ref);
+	acb_poly_set_coeff_si(ref, 0, 1);
+	acb_poly_set_coeff_si(ref, 1, 1);
+	acb_poly_set(res, ref);
+	acb_ode_solve_fuchs(ref, ODE, 20, 128);
+	if (!acb_ode_solve_fuchs_d(res, ODE, 20) || !acb_poly_contains(res, ref))
+		return_value = EXIT_FAILURE | 0x40;
+	acb_ode_clear(ODE);
+
+	acb_clear(x);
+	acb_clear(y);
+	_acb_vec_clear(path, 3);
+	_acb_vec_clear(val, 4);
+	acb_poly_clear(ref);
+	acb_poly_clear(res);
+	flint_randclear(state);
+	flint_cleanup();
+	return return_value;
+}
@@ -0,0 +1,108 @@
+#include "cascade.h"
+
+static int ode_equal (acb_ode_t A, acb_ode_t B, int exact)
+{
+	if (order(A) != order(B) || degree(A) != degree(B))
+		return 0;
+	for (slong i = 0; i <= order(A); i++)
+		for (slong j = 0; j <= degree(A); j++)
+			if (exact ? !acb_equal(acb_ode_coeff(A, i, j), acb_ode_coeff(B, i, j))
+				: !acb_overlaps(acb_ode_coeff(A, i, j), acb_ode_coeff(B, i, j)))
+				return 0;
+	return 1;
+}
+
+int main ()
+{
+	int return_value = EXIT_SUCCESS;
+	slong prec = 64;
+	char str[256];
+
+	FILE *in;
+	acb_t nu;
+	acb_ode_t ODE, ref;
+
+	acb_init(nu);
+
+	/* Both forms give Legendre's equation exactly */
+	for (ulong n = 0; n < 10 && return_value == EXIT_SUCCESS; n++)
+	{
+		acb_ode_legendre(ref, n);
+
+		flint_sprintf(str, "(1 - z^2)*D^2 - 2 z D + %wu*(%wu+1)", n, n);
+		if (!acb_ode_parse(ODE, str, prec))
+			return_value = EXIT_FAILURE | 0x2;
+		else
+		{
+			if (!ode_equal(ODE, ref, 1))
+				return_value = EXIT_FAILURE | 0x2;
+			acb_ode_clear(ODE);
+		}
+
+		flint_sprintf(str, "{%wu, 0, 0; 0, -2, 0; 1, 0, -1}", n*(n+1));
+		if (!acb_ode_parse(ODE, str, prec))
+			return_value = EXIT_FAILURE | 0x4;
+		else
+		{
+			if (!ode_equal(ODE, ref, 1))
+				return_value = EXIT_FAILURE | 0x4;
+			acb_ode_clear(ODE);
+		}
+		acb_ode_clear(ref);
+	}
+
+	/* Rational and decimal coefficients are rounded like arb does */
+	acb_set_si(nu, 1);
+	acb_div_si(nu, nu, 3, prec);
+	acb_ode_bessel(ref, nu, prec);
+	if (!acb_ode_parse(ODE, "z^2*D^2 + z*D + z^2 - 1/9  # nu = 1/3", prec))
+		return_value = EXIT_FAILURE | 0x8;
+	else
+	{
+		if (!ode_equal(ODE, ref, 0))
+			return_value = EXIT_FAILURE | 0x8;
+		acb_ode_clear(ODE);
+	}
+	acb_ode_clear(ref);
+
+	if (!acb_ode_parse(ODE, "[0.5 +/- 1e-10] z D^3 + 2.5e1 I", prec))
+		return_value = EXIT_FAILURE | 0x10;
+	else
+	{
+		if (order(ODE) != 3 || degree(ODE) != 1
+			|| !arb_contains_si(acb_imagref(acb_ode_coeff(ODE, 0, 0)), 25)
+			|| arb_is_exact(acb_realref(acb_ode_coeff(ODE, 3, 1)))
+			|| !acb_is_zero(acb_ode_coeff(ODE, 3, 0)))
+			return_value = EXIT_FAILURE | 0x10;
+		acb_ode_clear(ODE);
+	}
+
+	/* Invalid input */
+	const char *invalid[] = {"", "z^2 + 1", "D z", "(D + 1) D", "1/0 D", "D^", "{1, 2; 3", "D + 1; D",
+		"z^4097 D", "D^200 D^57", "(1 + z^2)^2049 D", "z^99999999999999999999 D"};
+	for (slong k = 0; k < 12; k++)
+		if (acb_ode_parse(ODE, invalid[k], prec))
+		{
+			acb_ode_clear(ODE);
+			return_value = EXIT_FAILURE | 0x20;
+		}
+
+	/* Streams continue after an invalid operator */
+	in = tmpfile();
+	fputs("D^2 + 1;\n{1; 1 +;\n 2} ;\n# comment\n{1, z; 1};\nD - 1", in);
+	rewind(in);
+	int expected[] = {1, -1, -1, 1, 0};
+	for (slong k = 0; k < 5; k++)
+	{
+		int res = acb_ode_parse_file(ODE, in, prec);
+		if (res != expected[k])
+			return_value = EXIT_FAILURE | 0x40;
+		if (res > 0)
+			acb_ode_clear(ODE);
+	}
+	fclose(in);
+
+	acb_clear(nu);
+	flint_cleanup();
+	return return_value;
+}
@@ -0,0 +1,105 @@
+#include "cascade.h"
+#include <acb_mat.h>
+
+int main ()
+{
+	int return_value = EXIT_SUCCESS;
+
+	slong prec;
+
+	flint_rand_t state;
+
+	arb_t rad, dist;
+	acb_t nu, trace, expected;
+	acb_ptr corners;
+	acb_mat_t mono;
+	acb_ode_t ODE, ODE_shift;
+	acb_ode_path_t path, empty;
+
+	flint_randinit(state);
+	arb_init(rad);
+	arb_init(dist);
+	acb_init(nu);
+	acb_init(trace);
+	acb_init(expected);
+	corners = _acb_vec_init(3);
+	acb_mat_init(mono, 2, 2);
+	acb_ode_path_init(path);
+	acb_ode_path_init(empty);
+
+	for (slong iter = 0; iter < 10; iter++)
+	{
+		prec = 30 + n_randint(state, 64);
+
+		/* Legendre's equation has singularities at 1 and -1 */
+		acb_ode_legendre(ODE, 1 + n_randint(state, 10));
+		acb_ode_init_blank(ODE_shift, degree(ODE), order(ODE));
+
+		acb_zero(corners);
+		acb_set_d_d(corners + 1, 0.5, 0.5);
+		acb_set_d(corners + 2, 0.96875);
+		if (!acb_ode_path_adaptive(path, ODE, corners, 3, prec)
+				|| !acb_equal(path->points + path->length - 1, corners + 2))
+		{
+			return_value = EXIT_FAILURE | 0x2;
+			break;
+		}
+
+		/* Without corners, the path is empty */
+		if (!acb_ode_path_adaptive(empty, ODE, NULL, 0, prec) || empty->length != 0)
+		{
+			return_value = EXIT_FAILURE | 0x2;
+			break;
+		}
+
+		/* Every step stays within the disk of convergence */
+		for (slong k = 0; k+1 < path->length; k++)
+		{
+			acb_ode_shift(ODE_shift, ODE, path->points + k, prec);
+			radius_of_convergence(rad, ODE_shift, 20, prec);
+			acb_sub(trace, path->points + k + 1, path->points + k, prec);
+			acb_abs(dist, trace, prec);
+			if (!arb_lt(dist, rad) || path->terms[k] <= 0)
+				return_value = EXIT_FAILURE | 0x4;
+		}
+
+		acb_ode_clear(ODE_shift);
+		acb_ode_clear(ODE);
+		if (return_value != EXIT_SUCCESS)
+			break;
+
+		/* Bessel's equation has exponents +nu and -nu at the origin */
+		acb_set_si(nu, 1 + n_randint(state, 15));
+		acb_div_si(nu, nu, 16, prec);
+		acb_set(trace, nu);
+		acb_ode_bessel(ODE, trace, prec);
+
+		find_monodromy_matrix(mono, ODE, prec);
+		acb_add(trace, acb_mat_entry(mono, 0, 0), acb_mat_entry(mono, 1, 1), prec);
+
+		arb_const_pi(rad, prec);
+		arb_mul_2exp_si(rad, rad, 1);
+		acb_mul_arb(expected, nu, rad, prec);
+		acb_cos(expected, expected, prec);
+		acb_mul_2exp_si(expected, expected, 1);
+		if (!acb_overlaps(trace, expected))
+			return_value = EXIT_FAILURE | 0x8;
+
+		acb_ode_clear(ODE);
+		if (return_value != EXIT_SUCCESS)
+			break;
+	}
+
+	acb_ode_path_clear(path);
+	acb_ode_path_clear(empty);
+	acb_mat_clear(mono);
+	_acb_vec_clear(corners, 3);
+	arb_clear(rad);
+	arb_clear(dist);
+	acb_clear(nu);
+	acb_clear(trace);
+	acb_clear(expected);
+	flint_randclear(state);
+	flint_cleanup();
+	return return_value;
+}
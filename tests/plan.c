@@ -0,0 +1,66 @@
+#include "cascade.h"
+#include <acb_poly.h>
+
+int main ()
+{
+	int return_value = EXIT_SUCCESS;
+
+	slong prec, n, b;
+
+	flint_rand_t state;
+
+	acb_t value, expected;
+	acb_poly_t result;
+	acb_ode_t ODE;
+	acb_ode_plan_t plan;
+
+	flint_randinit(state);
+	acb_init(value);
+	acb_init(expected);
+	acb_poly_init(result);
+
+	for (slong iter = 0; iter < 100; iter++)
+	{
+		prec = 30 + n_randint(state, 128);
+
+		acb_ode_random(ODE, state, prec);
+		if (acb_contains_zero(acb_ode_coeff(ODE, order(ODE), 0)))
+			acb_one(acb_ode_coeff(ODE, order(ODE), 0));
+
+		acb_ode_plan_init(plan, ODE);
+
+		/* The diagonals agree with the indicial polynomials */
+		for (slong d = 0; d <= plan->length && return_value == EXIT_SUCCESS; d++)
+		{
+			b = n_randint(state, 64);
+			acb_ode_plan_evaluate(value, plan, d, b, prec);
+			acb_set_si(expected, b);
+			indicial_polynomial_evaluate(expected, ODE, d, expected, 0, prec);
+			if (!acb_overlaps(value, expected))
+				return_value = EXIT_FAILURE | 0x2;
+		}
+
+		/* One plan serves many initial values */
+		for (slong k = 0; k < 3 && return_value == EXIT_SUCCESS; k++)
+		{
+			n = order(ODE) + n_randint(state, 32);
+			acb_poly_randtest(result, state, order(ODE) + 1, prec, 8);
+			_acb_ode_solve_fuchs(result, plan, n, prec);
+			if (!acb_ode_solves(ODE, result, n-order(ODE), prec))
+				return_value = EXIT_FAILURE | 0x4;
+		}
+
+		acb_ode_plan_clear(plan);
+		acb_ode_clear(ODE);
+
+		if (return_value != EXIT_SUCCESS)
+			break;
+	}
+
+	acb_poly_clear(result);
+	acb_clear(value);
+	acb_clear(expected);
+	flint_randclear(state);
+	flint_cleanup();
+	return return_value;
+}
@@ -0,0 +1,175 @@
+#include "cascade.h"
+#include <acb_mat.h>
+
+/* The continuation does not enclose the truncation error */
+static int nearly_equal (acb_t x, acb_t y, slong prec)
+{
+	int res;
+	arb_t dist, tol;
+	acb_t diff;
+	arb_init(dist);
+	arb_init(tol);
+	acb_init(diff);
+
+	acb_sub(diff, x, y, prec);
+	acb_abs(dist, diff, prec);
+	acb_abs(tol, y, prec);
+	arb_add_si(tol, tol, 1, prec);
+	arb_mul_2exp_si(tol, tol, 16 - prec);
+	res = acb_overlaps(x, y) || arb_le(dist, tol);
+
+	arb_clear(dist);
+	arb_clear(tol);
+	acb_clear(diff);
+	return res;
+}
+
+int main ()
+{
+	int return_value = EXIT_SUCCESS;
+
+	slong prec;
+
+	flint_rand_t state;
+
+	arb_t rad, dist;
+	acb_t nu, trace, expected;
+	acb_ptr corners;
+	acb_poly_t res, direct;
+	acb_mat_t mono;
+	acb_ode_t ODE;
+	acb_ode_sing_t sing;
+	acb_ode_path_t path, straight;
+
+	flint_randinit(state);
+	arb_init(rad);
+	arb_init(dist);
+	acb_init(nu);
+	acb_init(trace);
+	acb_init(expected);
+	corners = _acb_vec_init(2);
+	acb_poly_init(res);
+	acb_poly_init(direct);
+	acb_mat_init(mono, 2, 2);
+	acb_ode_sing_init(sing);
+	acb_ode_path_init(path);
+	acb_ode_path_init(straight);
+
+	for (slong iter = 0; iter < 4; iter++)
+	{
+		prec = 30 + n_randint(state, 32);
+
+		/* Pass close to the singularity of Legendre's equation at 1 */
+		acb_ode_legendre(ODE, 1 + n_randint(state, 10));
+		acb_ode_singularities(sing, ODE, prec);
+
+		acb_set_d_d(corners, 0.5, -0.125);
+		acb_set_d_d(corners + 1, 1.5, -0.125);
+		if (n_randint(state, 2))
+			acb_conj(corners + 1, corners + 1);
+		if (!acb_ode_path_plan(path, sing, corners, corners + 1, prec)
+				|| !acb_equal(path->points, corners)
+				|| !acb_equal(path->points + path->length - 1, corners + 1))
+		{
+			return_value = EXIT_FAILURE | 0x2;
+			break;
+		}
+
+		/* The straight line from 0 to 2 runs into the singularity at 1 */
+		acb_zero(expected);
+		acb_set_si(trace, 2);
+		if (acb_ode_path_plan(straight, sing, expected, trace, prec))
+		{
+			return_value = EXIT_FAILURE | 0x2;
+			break;
+		}
+
+		/* Every step stays within the disk of convergence */
+		for (slong k = 0; k+1 < path->length; k++)
+		{
+			acb_ode_sing_distance(rad, sing, path->points + k, prec);
+			acb_sub(trace, path->points + k + 1, path->points + k, prec);
+			acb_abs(dist, trace, prec);
+			if (!arb_lt(dist, rad) || path->terms[k] <= 0)
+				return_value = EXIT_FAILURE | 0x4;
+		}
+
+		/* The planned path is homotopic to the straight line */
+		acb_poly_zero(res);
+		acb_poly_set_coeff_si(res, 0, 1);
+		acb_poly_set_coeff_si(res, 1, n_randint(state, 3));
+		acb_poly_set(direct, res);
+		analytic_continuation_path(res, ODE, path, prec);
+		acb_ode_path_adaptive(straight, ODE, corners, 2, prec);
+		analytic_continuation_path(direct, ODE, straight, prec);
+		for (slong j = 0; j < 2; j++)
+		{
+			acb_poly_get_coeff_acb(trace, res, j);
+			acb_poly_get_coeff_acb(expected, direct, j);
+			if (!nearly_equal(trace, expected, prec))
+				return_value = EXIT_FAILURE | 0x8;
+		}
+
+		/* A loop around 1 is unipotent, since both exponents vanish */
+		acb_one(trace);
+		acb_set_d(corners, 0.5);
+		if (!acb_ode_path_loop(path, sing, corners, acb_contains(sing->points, trace) ? 0 : 1, prec))
+		{
+			return_value = EXIT_FAILURE | 0x10;
+			break;
+		}
+		acb_ode_path_transition_matrix(mono, ODE, path, prec);
+		acb_add(trace, acb_mat_entry(mono, 0, 0), acb_mat_entry(mono, 1, 1), prec);
+		acb_set_si(expected, 2);
+		if (!nearly_equal(trace, expected, prec))
+			return_value = EXIT_FAILURE | 0x10;
+
+		acb_ode_clear(ODE);
+		if (return_value != EXIT_SUCCESS)
+			break;
+
+		/* Bessel's equation has exponents +nu and -nu at the origin */
+		acb_set_si(nu, 1 + n_randint(state, 15));
+		acb_div_si(nu, nu, 16, prec);
+		acb_set(trace, nu);
+		acb_ode_bessel(ODE, trace, prec);
+		acb_ode_singularities(sing, ODE, prec);
+
+		acb_set_d_d(corners, 0.75, 0.25);
+		if (sing->length != 1 || !acb_ode_path_loop(path, sing, corners, 0, prec))
+		{
+			return_value = EXIT_FAILURE | 0x20;
+			break;
+		}
+		acb_ode_path_transition_matrix(mono, ODE, path, prec);
+		acb_add(trace, acb_mat_entry(mono, 0, 0), acb_mat_entry(mono, 1, 1), prec);
+
+		arb_const_pi(rad, prec);
+		arb_mul_2exp_si(rad, rad, 1);
+		acb_mul_arb(expected, nu, rad, prec);
+		acb_cos(expected, expected, prec);
+		acb_mul_2exp_si(expected, expected, 1);
+		if (!nearly_equal(trace, expected, prec))
+			return_value = EXIT_FAILURE | 0x40;
+
+		acb_ode_clear(ODE);
+		if (return_value != EXIT_SUCCESS)
+			break;
+	}
+
+	acb_ode_path_clear(path);
+	acb_ode_path_clear(straight);
+	acb_ode_sing_clear(sing);
+	acb_mat_clear(mono);
+	acb_poly_clear(res);
+	acb_poly_clear(direct);
+	_acb_vec_clear(corners, 2);
+	arb_clear(rad);
+	arb_clear(dist);
+	acb_clear(nu);
+	acb_clear(trace);
+	acb_clear(expected);
+	flint_randclear(state);
+	flint_cleanup();
+	return return_value;
+}
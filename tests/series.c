@@ -0,0 +1,96 @@
+#include "cascade.h"
+
+static int solutions_overlap (acb_ode_solution_t a, acb_ode_solution_t b)
+{
+	for (slong i = 0; i < a->M; i++)
+		if (!acb_poly_overlaps(a->gens + i, b->gens + i))
+			return 0;
+	return 1;
+}
+
+int main ()
+{
+	int return_value = EXIT_SUCCESS;
+
+	slong prec, n, deg;
+
+	flint_rand_t state;
+
+	mag_t eta, err;
+	acb_t nu, nu2;
+	acb_poly_t init, ref;
+	acb_ode_t ODE;
+	acb_ode_series_t S;
+	acb_ode_solution_t sol;
+
+	flint_randinit(state);
+	mag_init(eta);
+	mag_init(err);
+	acb_init(nu);
+	acb_init(nu2);
+	acb_poly_init(init);
+	acb_poly_init(ref);
+
+	for (slong iter = 0; iter < 40; iter++)
+	{
+		prec = 30 + n_randint(state, 64);
+		n = 10 + n_randint(state, 40);
+
+		/* Power series solutions extended in several steps agree with a single run */
+		acb_ode_legendre(ODE, n_randint(state, 10));
+		acb_poly_zero(init);
+		acb_poly_set_coeff_si(init, 0, 1);
+		acb_poly_set_coeff_si(init, 1, n_randint(state, 3));
+		acb_poly_set(ref, init);
+		acb_ode_solve_fuchs(ref, ODE, 3*n, prec);
+
+		acb_ode_series_init_fuchs(S, ODE, init, prec);
+		acb_ode_series_extend(S, n);
+		acb_ode_series_extend(S, n/2);
+		acb_ode_series_extend(S, 3*n);
+		if (!acb_poly_equal(acb_ode_series_solution(S)->gens, ref) || S->length != 3*n + 1)
+			return_value = EXIT_FAILURE | 0x2;
+		acb_ode_series_clear(S);
+		acb_ode_clear(ODE);
+
+		/* Bessel's equation has a logarithm if nu = 0 */
+		slong mul = 1 + n_randint(state, 2);
+		acb_set_si(nu, (mul == 1) ? 1 + n_randint(state, 7) : 0);
+		acb_div_si(nu, nu, 16, prec);
+		acb_set(nu2, nu);
+		acb_ode_bessel(ODE, nu2, prec);
+
+		acb_ode_solution_init(sol, nu, mul, 0);
+		acb_ode_solve_frobenius(sol, ODE, 2*n, prec);
+		acb_ode_series_init_frobenius(S, ODE, nu, mul, 0, prec);
+		acb_ode_series_extend(S, n);
+		acb_ode_series_extend(S, 2*n);
+		if (!solutions_overlap(acb_ode_series_solution(S), sol))
+			return_value = EXIT_FAILURE | 0x4;
+		acb_ode_solution_clear(sol);
+
+		/* Tail bounds continue from the known coefficients */
+		mag_set_ui(eta, 1 + n_randint(state, 4));
+		deg = acb_ode_series_extend_tail(err, S, eta, 200);
+		acb_ode_solution_init(sol, nu, mul, 0);
+		acb_ode_solve_frobenius(sol, ODE, deg, prec);
+		if (deg < 2*n || deg >= 200 || !mag_is_finite(err) || !solutions_overlap(acb_ode_series_solution(S), sol))
+			return_value = EXIT_FAILURE | 0x8;
+		acb_ode_solution_clear(sol);
+
+		acb_ode_series_clear(S);
+		acb_ode_clear(ODE);
+		if (return_value != EXIT_SUCCESS)
+			break;
+	}
+
+	mag_clear(eta);
+	mag_clear(err);
+	acb_clear(nu);
+	acb_clear(nu2);
+	acb_poly_clear(init);
+	acb_poly_clear(ref);
+	flint_randclear(state);
+	flint_cleanup();
+	return return_value;
+}
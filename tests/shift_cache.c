@@ -0,0 +1,62 @@
+#include "acb_ode.h"
+#include <acb.h>
+#include <flint/flint.h>
+
+int main ()
+{
+	int return_value = EXIT_SUCCESS;
+	slong prec, len;
+
+	acb_t a;
+	acb_ode_t ode, shift;
+	acb_ode_struct *cached;
+	acb_ode_shift_cache_t cache;
+	flint_rand_t state;
+
+	flint_randinit(state);
+	acb_init(a);
+
+	for (slong iter = 0; iter < 100; iter++)
+	{
+		prec = 30 + n_randint(state, 128);
+
+		acb_ode_random(ode, state, prec);
+		acb_ode_init_blank(shift, degree(ode), order(ode));
+		acb_ode_shift_cache_init(cache, ode, prec);
+
+		/* Walk along a random path, and come back to some points */
+		for (slong k = 0; k < 20; k++)
+		{
+			acb_set_si_si(a, n_randint(state, 9) - 4, n_randint(state, 9) - 4);
+			acb_mul_2exp_si(a, a, -2);
+
+			len = cache->length;
+			cached = acb_ode_shift_cache_get(cache, a);
+			if (acb_ode_shift_cache_get(cache, a) != cached || cache->length > len + 1)
+			{
+				return_value = EXIT_FAILURE | 0x2;
+				break;
+			}
+
+			acb_ode_shift(shift, ode, a, prec);
+			for (slong i = 0; i <= order(ode); i++)
+				for (slong j = 0; j <= degree(ode); j++)
+					if (!acb_overlaps(acb_ode_coeff(shift, i, j), acb_ode_coeff(cached, i, j)))
+						return_value = EXIT_FAILURE | 0x4;
+			if (return_value != EXIT_SUCCESS)
+				break;
+		}
+
+		acb_ode_shift_cache_clear(cache);
+		acb_ode_clear(shift);
+		acb_ode_clear(ode);
+
+		if (return_value != EXIT_SUCCESS)
+			break;
+	}
+
+	acb_clear(a);
+	flint_randclear(state);
+	flint_cleanup();
+	return return_value;
+}
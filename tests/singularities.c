@@ -0,0 +1,144 @@
+#include "cascade.h"
+
+int main ()
+{
+	int return_value = EXIT_SUCCESS;
+
+	slong prec, n, total;
+
+	flint_rand_t state;
+
+	arb_t rad;
+	acb_t z;
+	acb_ptr roots;
+	acb_poly_t lead;
+	acb_ode_t ODE;
+	acb_ode_sing_t sing;
+
+	flint_randinit(state);
+	arb_init(rad);
+	acb_init(z);
+	acb_poly_init(lead);
+	acb_ode_sing_init(sing);
+
+	prec = 64;
+
+	/* Legendre's equation has regular singularities at 1 and -1 */
+	acb_ode_legendre(ODE, 3);
+	acb_ode_singularities(sing, ODE, prec);
+	if (sing->length != 2 || sing->mul[0] != 1 || sing->mul[1] != 1
+			|| sing->type[0] != ACB_ODE_SING_REGULAR || sing->type[1] != ACB_ODE_SING_REGULAR)
+		return_value = EXIT_FAILURE | 0x2;
+	acb_zero(z);
+	acb_ode_sing_distance(rad, sing, z, prec);
+	if (!arb_is_positive(rad) || arf_cmp_si(arb_midref(rad), 1) > 0)
+		return_value = EXIT_FAILURE | 0x2;
+	acb_one(z);
+	acb_ode_sing_distance(rad, sing, z, prec);
+	if (!arb_is_zero(rad))
+		return_value = EXIT_FAILURE | 0x2;
+	_acb_ode_sing_distance(rad, sing, z, acb_contains(sing->points, z) ? 0 : 1, prec);
+	if (!arb_is_positive(rad) || arf_cmp_si(arb_midref(rad), 2) > 0)
+		return_value = EXIT_FAILURE | 0x2;
+	acb_ode_clear(ODE);
+
+	/* z^3 y'' + y = 0 is irregular at zero */
+	acb_ode_init_blank(ODE, 3, 2);
+	acb_one(acb_ode_coeff(ODE, 2, 3));
+	acb_one(acb_ode_coeff(ODE, 0, 0));
+	acb_ode_singularities(sing, ODE, prec);
+	if (sing->length != 1 || sing->mul[0] != 3 || sing->type[0] != ACB_ODE_SING_IRREGULAR)
+		return_value = EXIT_FAILURE | 0x4;
+	acb_ode_clear(ODE);
+
+	/* (z^2 - 2^-800)y'' + y' = 0 has two regular singular points, which do not separate at this precision */
+	acb_ode_init_blank(ODE, 2, 2);
+	acb_one(acb_ode_coeff(ODE, 2, 2));
+	acb_one(acb_ode_coeff(ODE, 2, 0));
+	acb_mul_2exp_si(acb_ode_coeff(ODE, 2, 0), acb_ode_coeff(ODE, 2, 0), -800);
+	acb_neg(acb_ode_coeff(ODE, 2, 0), acb_ode_coeff(ODE, 2, 0));
+	acb_one(acb_ode_coeff(ODE, 1, 0));
+	acb_ode_singularities(sing, ODE, prec);
+	for (slong k = 0; k < sing->length; k++)
+		if (sing->type[k] == ACB_ODE_SING_IRREGULAR || (sing->mul[k] > 1 && sing->type[k] != ACB_ODE_SING_UNKNOWN))
+			return_value = EXIT_FAILURE | 0x4;
+	acb_ode_clear(ODE);
+
+	/* (z-1)y'' - 2y' = 0 has the solutions 1 and (z-1)^3 */
+	acb_ode_init_blank(ODE, 1, 2);
+	acb_set_si(acb_ode_coeff(ODE, 2, 0), -1);
+	acb_one(acb_ode_coeff(ODE, 2, 1));
+	acb_set_si(acb_ode_coeff(ODE, 1, 0), -2);
+	acb_ode_singularities(sing, ODE, prec);
+	if (sing->length != 1 || sing->type[0] != ACB_ODE_SING_APPARENT)
+		return_value = EXIT_FAILURE | 0x8;
+	acb_ode_clear(ODE);
+
+	/* zy'' + y = 0 has integer exponents, but a logarithmic solution */
+	acb_ode_init_blank(ODE, 1, 2);
+	acb_one(acb_ode_coeff(ODE, 2, 1));
+	acb_one(acb_ode_coeff(ODE, 0, 0));
+	acb_ode_singularities(sing, ODE, prec);
+	if (sing->length != 1 || sing->type[0] != ACB_ODE_SING_REGULAR)
+		return_value = EXIT_FAILURE | 0x10;
+	acb_ode_clear(ODE);
+
+	for (slong iter = 0; iter < 100 && return_value == EXIT_SUCCESS; iter++)
+	{
+		prec = 30 + n_randint(state, 128);
+
+		/* Leading coefficient with known (possibly repeated) roots */
+		n = 1 + n_randint(state, 8);
+		roots = _acb_vec_init(n);
+		for (slong k = 0; k < n; k++)
+		{
+			if (k > 0 && n_randint(state, 4) == 0)
+				acb_set(roots + k, roots + k - 1);
+			else
+			{
+				acb_set_si_si(roots + k, n_randint(state, 33) - 16, n_randint(state, 33) - 16);
+				acb_mul_2exp_si(roots + k, roots + k, -3);
+			}
+		}
+		acb_poly_product_roots(lead, roots, n, prec);
+
+		acb_ode_init_blank(ODE, n, 1 + n_randint(state, 3));
+		for (slong j = 0; j <= n; j++)
+			acb_poly_get_coeff_acb(acb_ode_coeff(ODE, order(ODE), j), lead, j);
+
+		acb_ode_singularities(sing, ODE, prec);
+
+		total = 0;
+		for (slong k = 0; k < sing->length; k++)
+			total += sing->mul[k];
+		if (total != n)
+			return_value = EXIT_FAILURE | 0x20;
+
+		/* Every root lies in a point with at least its multiplicity */
+		for (slong k = 0; k < n; k++)
+		{
+			slong found = 0, mul = 0;
+			for (slong j = 0; j < sing->length; j++)
+				if (acb_contains(sing->points + j, roots + k))
+				{
+					found++;
+					mul = sing->mul[j];
+				}
+			for (slong j = 0; j < n; j++)
+				mul -= acb_equal(roots + j, roots + k);
+			if (found != 1 || mul < 0)
+				return_value = EXIT_FAILURE | 0x40;
+		}
+
+		acb_ode_clear(ODE);
+		_acb_vec_clear(roots, n);
+	}
+
+	acb_ode_sing_clear(sing);
+	acb_poly_clear(lead);
+	acb_clear(z);
+	arb_clear(rad);
+	flint_randclear(state);
+	flint_cleanup();
+	return return_value;
+}
@@ -0,0 +1,58 @@
+#include "acb_ode.h"
+
+int main ()
+{
+	/* Init */
+	int return_value = EXIT_SUCCESS;
+	slong prec, n;
+	acb_ode_solution_t sol, ser;
+	acb_poly_t f, g, h;
+	acb_t rho, val;
+
+	flint_rand_t state;
+	flint_randinit(state);
+
+	acb_init(rho);
+	acb_init(val);
+	acb_poly_init(f);
+	acb_poly_init(g);
+	acb_poly_init(h);
+
+	for (slong iter = 0; iter < 100; iter++)
+	{
+		prec = 30 + n_randint(state, 128);
+		n = 2 + n_randint(state, 10);
+
+		acb_randtest(rho, state, prec, 16);
+		acb_ode_solution_init(sol, rho, 1 + n_randint(state, 5), 0);
+		acb_ode_solution_init(ser, rho, sol->mul, 0);
+
+		/* The Taylor expansion at rho gives the same generators as the polynomial itself */
+		for (slong i = 0; i < n; i++)
+		{
+			acb_poly_randtest(f, state, 20, prec, 16);
+			acb_poly_set(g, f);
+			acb_poly_taylor_shift(h, f, sol->rho, prec);
+			_acb_ode_solution_extend(sol, i, g, prec);
+			_acb_ode_solution_extend_series(ser, i, h, prec);
+			for (slong j = 0; j < sol->mul; j++)
+			{
+				acb_poly_get_coeff_acb(rho, sol->gens + j, i);
+				acb_poly_get_coeff_acb(val, ser->gens + j, i);
+				if (!acb_overlaps(rho, val))
+					return_value = EXIT_FAILURE;
+			}
+		}
+
+		acb_ode_solution_clear(sol);
+		acb_ode_solution_clear(ser);
+	}
+	acb_clear(rho);
+	acb_clear(val);
+	acb_poly_clear(f);
+	acb_poly_clear(g);
+	acb_poly_clear(h);
+	flint_randclear(state);
+	flint_cleanup();
+	return return_value;
+}
@@ -0,0 +1,107 @@
+#include "acb_ode.h"
+
+int main ()
+{
+	int return_value = EXIT_SUCCESS;
+	slong prec, num, len;
+	fmpz_t binom;
+	acb_t rho;
+	acb_ptr points, res;
+	acb_poly_t x, log, pow, g, sum, term;
+	acb_ode_solution_t sol;
+	flint_rand_t state;
+
+	flint_randinit(state);
+	fmpz_init(binom);
+	acb_init(rho);
+	acb_poly_init(x);
+	acb_poly_init(log);
+	acb_poly_init(pow);
+	acb_poly_init(g);
+	acb_poly_init(sum);
+	acb_poly_init(term);
+
+	for (slong iter = 0; iter < 100; iter++)
+	{
+		prec = 30 + n_randint(state, 128);
+		num = 1 + n_randint(state, 50);
+		len = 1 + n_randint(state, 5);
+
+		acb_randtest(rho, state, prec, 4);
+		acb_ode_solution_init(sol, rho, 1 + n_randint(state, 4), 0);
+		for (slong i = 0; i < sol->M; i++)
+			acb_poly_randtest(sol->gens + i, state, 1 + n_randint(state, 50), prec, 4);
+
+		points = _acb_vec_init(num);
+		res = _acb_vec_init(num * len);
+		for (slong j = 0; j < num; j++)
+			acb_randtest(points + j, state, prec, 2);
+		acb_ode_solution_evaluate_vec(res, sol, points, num, len, prec);
+
+		for (slong j = 0; j < num && return_value == EXIT_SUCCESS; j++)
+		{
+			if (acb_is_zero(points + j))
+				continue;
+
+			/* Expand every factor as a power series in t at z = a + t */
+			acb_poly_zero(x);
+			acb_poly_set_coeff_acb(x, 0, points + j);
+			acb_poly_set_coeff_si(x, 1, 1);
+			acb_poly_log_series(log, x, len, prec);
+			acb_poly_pow_acb_series(pow, x, sol->rho, len, prec);
+
+			acb_poly_zero(sum);
+			for (slong i = 0; i < sol->M; i++)
+			{
+				/* The Taylor expansion of g_i, from its derivatives */
+				acb_poly_set(g, sol->gens + i);
+				acb_poly_zero(term);
+				for (slong k = 0; k < len; k++)
+				{
+					acb_poly_evaluate(rho, g, points + j, prec);
+					fmpz_fac_ui(binom, k);
+					acb_div_fmpz(rho, rho, binom, prec);
+					acb_poly_set_coeff_acb(term, k, rho);
+					acb_poly_derivative(g, g, prec);
+				}
+				fmpz_bin_uiui(binom, sol->M - 1, i);
+				acb_set_fmpz(rho, binom);
+				acb_poly_scalar_mul(term, term, rho, prec);
+				for (slong k = i + 1; k < sol->M; k++)
+					acb_poly_mullow(term, term, log, len, prec);
+				acb_poly_add(sum, sum, term, prec);
+			}
+			acb_poly_mullow(sum, sum, pow, len, prec);
+
+			for (slong k = 0; k < len; k++)
+			{
+				acb_poly_get_coeff_acb(rho, sum, k);
+				if (!acb_overlaps(rho, res + j*len + k))
+					return_value = EXIT_FAILURE | 0x2;
+			}
+
+			/* The single point evaluation agrees with the first coefficient */
+			acb_ode_solution_evaluate(rho, sol, points + j, prec);
+			if (!acb_overlaps(rho, res + j*len))
+				return_value = EXIT_FAILURE | 0x4;
+		}
+
+		_acb_vec_clear(points, num);
+		_acb_vec_clear(res, num * len);
+		acb_ode_solution_clear(sol);
+		if (return_value != EXIT_SUCCESS)
+			break;
+	}
+
+	acb_clear(rho);
+	acb_poly_clear(x);
+	acb_poly_clear(log);
+	acb_poly_clear(pow);
+	acb_poly_clear(g);
+	acb_poly_clear(sum);
+	acb_poly_clear(term);
+	fmpz_clear(binom);
+	flint_randclear(state);
+	flint_cleanup();
+	return return_value;
+}
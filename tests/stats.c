@@ -0,0 +1,103 @@
+#include "cascade.h"
+
+typedef struct {
+	slong coeffs;
+	slong segments;
+	slong next;	/* index of the next coefficient */
+	slong accuracy;
+	int ordered;
+} event_counts;
+
+static void count_event (const acb_ode_event_struct *event, void *data)
+{
+	event_counts *counts = data;
+	if (event->kind == ACB_ODE_EVENT_COEFFICIENT)
+	{
+		counts->ordered &= (event->index >= counts->next);
+		counts->next = event->index + 1;
+		counts->coeffs++;
+		counts->accuracy = FLINT_MIN(counts->accuracy, event->accuracy);
+	}
+	else
+	{
+		counts->ordered &= (event->index == counts->segments && event->terms > 0);
+		counts->segments++;
+	}
+}
+
+int main ()
+{
+	int return_value = EXIT_SUCCESS;
+
+	slong prec, n;
+
+	flint_rand_t state;
+
+	acb_ptr path;
+	acb_poly_t res;
+	acb_ode_t ODE;
+	acb_ode_stats_t stats;
+	event_counts counts;
+
+	flint_randinit(state);
+	path = _acb_vec_init(3);
+	acb_poly_init(res);
+
+	for (slong iter = 0; iter < 40; iter++)
+	{
+		prec = 30 + n_randint(state, 128);
+		n = 10 + n_randint(state, 50);
+		acb_ode_legendre(ODE, n_randint(state, 10));
+
+		/* Every coefficient is reported once, in order */
+		acb_ode_stats_init(stats);
+		stats->per_coefficient = 1;
+		stats->callback = count_event;
+		stats->data = &counts;
+		counts.coeffs = counts.segments = counts.next = 0;
+		counts.accuracy = ARF_PREC_EXACT;
+		counts.ordered = 1;
+		acb_ode_stats_enable(stats);
+
+		acb_poly_one(res);
+		acb_ode_solve_fuchs(res, ODE, n, prec);
+		if (stats->coeffs != n + 1 - order(ODE) || counts.coeffs != stats->coeffs
+				|| stats->calls[ACB_ODE_STAGE_RECURRENCE] != 1 || stats->evaluations <= 0
+				|| stats->accuracy != counts.accuracy || !counts.ordered)
+			return_value = EXIT_FAILURE | 0x2;
+
+		/* Each step of the path is a segment */
+		acb_zero(path);
+		acb_set_d_d(path + 1, 0.25, 0.25);
+		acb_set_d_d(path + 2, 0.5, 0);
+		stats->per_coefficient = 0;
+		counts.coeffs = 0;
+		acb_poly_one(res);
+		analytic_continuation(res, ODE, path, 3, n, prec);
+		if (counts.coeffs != 0 || counts.segments != 2 || stats->segments != 2 || !counts.ordered
+				|| stats->calls[ACB_ODE_STAGE_TAYLOR_SHIFT] != 2 || stats->calls[ACB_ODE_STAGE_SHIFT] < 2)
+			return_value = EXIT_FAILURE | 0x4;
+		for (slong s = 0; s < ACB_ODE_NUM_STAGES; s++)
+			if (stats->time[s] < 0 || (stats->calls[s] == 0 && stats->time[s] != 0))
+				return_value = EXIT_FAILURE | 0x4;
+
+		/* Nothing is recorded once disabled */
+		acb_ode_stats_disable();
+		n = stats->coeffs;
+		acb_poly_one(res);
+		acb_ode_solve_fuchs(res, ODE, 2*n, prec);
+		analytic_continuation(res, ODE, path, 3, n, prec);
+		if (stats->coeffs != n || counts.segments != 2)
+			return_value = EXIT_FAILURE | 0x8;
+
+		acb_ode_clear(ODE);
+		if (return_value != EXIT_SUCCESS)
+			break;
+	}
+
+	_acb_vec_clear(path, 3);
+	acb_poly_clear(res);
+	flint_randclear(state);
+	flint_cleanup();
+	return return_value;
+}
@@ -0,0 +1,73 @@
+#include "cascade.h"
+
+int main ()
+{
+	int return_value = EXIT_SUCCESS;
+
+	slong prec, n, len;
+
+	flint_rand_t state;
+
+	acb_t c, x;
+	acb_ptr val;
+	acb_poly_t init, ref;
+	acb_ode_t ODE;
+	acb_ode_plan_t plan;
+	acb_ode_stream_t st;
+
+	flint_randinit(state);
+	acb_init(c);
+	acb_init(x);
+	val = _acb_vec_init(6);
+	acb_poly_init(init);
+	acb_poly_init(ref);
+
+	for (slong iter = 0; iter < 100; iter++)
+	{
+		prec = 30 + n_randint(state, 128);
+
+		/* The window gives exactly the same coefficients as the full series */
+		acb_ode_random(ODE, state, prec);
+		n = order(ODE) + n_randint(state, 80);
+		acb_poly_randtest(init, state, order(ODE), prec, 4);
+		acb_poly_set(ref, init);
+		acb_ode_solve_fuchs(ref, ODE, n, prec);
+
+		acb_ode_plan_init(plan, ODE);
+		acb_ode_stream_init(st, plan, init, prec);
+		for (slong k = 0; k <= n; k++)
+		{
+			acb_ode_stream_next(c, st);
+			acb_poly_get_coeff_acb(x, ref, k);
+			if (!acb_equal(c, x))
+				return_value = EXIT_FAILURE | 0x2;
+		}
+		acb_ode_stream_clear(st);
+
+		/* The fused evaluation agrees with the Taylor shift of the series */
+		len = n_randint(state, 6);
+		acb_randtest(x, state, prec, 2);
+		acb_poly_taylor_shift(ref, ref, x, prec);
+		_acb_ode_solve_fuchs_evaluate(val, plan, init, x, n, len, prec);
+		for (slong k = 0; k < len; k++)
+		{
+			acb_poly_get_coeff_acb(c, ref, k);
+			if (!acb_overlaps(c, val + k))
+				return_value = EXIT_FAILURE | 0x4;
+		}
+
+		acb_ode_plan_clear(plan);
+		acb_ode_clear(ODE);
+		if (return_value != EXIT_SUCCESS)
+			break;
+	}
+
+	acb_clear(c);
+	acb_clear(x);
+	_acb_vec_clear(val, 6);
+	acb_poly_clear(init);
+	acb_poly_clear(ref);
+	flint_randclear(state);
+	flint_cleanup();
+	return return_value;
+}
@@ -0,0 +1,180 @@
+#include "cascade.h"
+
+static void actual_tail (mag_t res, acb_ode_solution_t sol, slong N, const mag_t eta)
+{
+	/* Lower bound for sum_{n >= N} sum_k |g_k[n]|/k! eta^n over the known coefficients */
+	mag_t t, p, f;
+	mag_init(t);
+	mag_init(p);
+	mag_init(f);
+
+	mag_zero(res);
+	for (slong k = 0; k < sol->M; k++)
+	{
+		mag_fac_ui(f, k);
+		for (slong n = N; n < acb_poly_length(sol->gens + k); n++)
+		{
+			acb_get_mag_lower(t, sol->gens[k].coeffs + n);
+			mag_pow_ui_lower(p, eta, n);
+			mag_mul_lower(t, t, p);
+			mag_div_lower(t, t, f);
+			mag_add_lower(res, res, t);
+		}
+	}
+
+	mag_clear(t);
+	mag_clear(p);
+	mag_clear(f);
+}
+
+static void actual_derivative_tail (mag_t res, const acb_poly_t f, slong N, slong j, const mag_t eta)
+{
+	/* Lower bound for sum_{n >= N} binom(n, j) |f_n| eta^(n-j) over the known coefficients */
+	mag_t t, p;
+	mag_init(t);
+	mag_init(p);
+
+	mag_zero(res);
+	for (slong n = FLINT_MAX(N, j); n < acb_poly_length(f); n++)
+	{
+		acb_get_mag_lower(t, f->coeffs + n);
+		mag_pow_ui_lower(p, eta, n - j);
+		mag_mul_lower(t, t, p);
+		for (slong i = 0; i < j; i++)
+		{
+			mag_mul_ui_lower(t, t, n - i);
+			mag_div_ui(t, t, i + 1);
+		}
+		mag_add_lower(res, res, t);
+	}
+
+	mag_clear(t);
+	mag_clear(p);
+}
+
+int main ()
+{
+	int return_value = EXIT_SUCCESS;
+
+	slong prec, n, max;
+
+	flint_rand_t state;
+
+	mag_t eta, err, tail;
+	mag_struct derivs[2];
+	arb_t dist, rad;
+	acb_t a, nu, nu2;
+	acb_ode_t ODE, ODE_shift;
+	acb_ode_plan_t plan;
+	acb_ode_tail_t bound;
+	acb_ode_solution_t sol, ref;
+
+	flint_randinit(state);
+	mag_init(eta);
+	mag_init(err);
+	mag_init(tail);
+	mag_init(derivs);
+	mag_init(derivs + 1);
+	arb_init(dist);
+	arb_init(rad);
+	acb_init(a);
+	acb_init(nu);
+	acb_init(nu2);
+
+	for (slong iter = 0; iter < 20; iter++)
+	{
+		prec = 30 + n_randint(state, 32);
+
+		/* Legendre's equation around a regular point, at most half way to the singularity */
+		acb_ode_legendre(ODE, 1 + n_randint(state, 10));
+		acb_ode_init_blank(ODE_shift, degree(ODE), order(ODE));
+		acb_set_si(a, n_randint(state, 9) - 4);
+		acb_div_si(a, a, 10, prec);
+		acb_ode_shift(ODE_shift, ODE, a, prec);
+
+		arb_set_si(dist, 1 + n_randint(state, 8));
+		arb_div_si(dist, dist, 16, prec);
+		arb_get_ubound_arf(arb_midref(dist), dist, prec);
+		arf_get_mag(eta, arb_midref(dist));
+		radius_of_convergence(rad, ODE_shift, 20, prec);
+		max = 4*truncation_order(dist, rad, prec) + 20;
+
+		acb_ode_solution_init(sol, nu, 1, 0);
+		acb_poly_set_coeff_si(sol->gens, 0, 1);
+		acb_poly_set_coeff_si(sol->gens, 1, n_randint(state, 3));
+		acb_ode_solution_init(ref, nu, 1, 0);
+		acb_poly_set(ref->gens, sol->gens);
+
+		n = acb_ode_solve_fuchs_tail(sol->gens, err, ODE_shift, eta, max, prec);
+		acb_ode_solve_fuchs(ref->gens, ODE_shift, 4*n + 20, prec);
+		actual_tail(tail, ref, n + 1, eta);
+		if (n >= max || !mag_is_finite(err) || mag_cmp(tail, err) > 0)
+			return_value = EXIT_FAILURE | 0x2;
+
+		/* The Taylor coefficients at a point of modulus eta have tails weighted by binomials */
+		acb_ode_plan_init(plan, ODE_shift);
+		acb_ode_tail_init(bound, plan, nu, 1, prec);
+		acb_ode_tail_bound_derivatives(derivs, bound, sol->gens, n + 1, eta, 2);
+		for (slong j = 0; j < 2; j++)
+		{
+			actual_derivative_tail(tail, ref->gens, n + 1, j, eta);
+			if (!mag_is_finite(derivs + j) || mag_cmp(tail, derivs + j) > 0)
+				return_value = EXIT_FAILURE | 0x2;
+		}
+		acb_ode_tail_clear(bound);
+		acb_ode_plan_clear(plan);
+
+		acb_ode_solution_clear(sol);
+		acb_ode_solution_clear(ref);
+		acb_ode_clear(ODE_shift);
+		acb_ode_clear(ODE);
+		if (return_value != EXIT_SUCCESS)
+			break;
+
+		/* Bessel's equation has exponents +nu and -nu, with a logarithm if nu = 0 */
+		slong mul = 1 + n_randint(state, 2);
+		acb_set_si(nu, (mul == 1) ? 1 + n_randint(state, 7) : 0);
+		acb_div_si(nu, nu, 16, prec);
+		acb_set(nu2, nu);
+		acb_ode_bessel(ODE, nu2, prec);
+		mag_set_ui(eta, 1 + n_randint(state, 4));
+
+		acb_ode_solution_init(sol, nu, mul, 0);
+		acb_ode_solution_init(ref, nu, mul, 0);
+		n = acb_ode_solve_frobenius_tail(sol, err, ODE, eta, 200, prec);
+		acb_ode_solve_frobenius(ref, ODE, 4*n + 20, prec);
+
+		/* The normalization of logarithmic solutions depends on the degree */
+		if (mul > 1)
+		{
+			acb_ode_plan_init(plan, ODE);
+			acb_ode_tail_init(bound, plan, nu, mul, prec);
+			acb_ode_tail_bound(err, bound, ref->gens, n + 1, eta);
+			acb_ode_tail_clear(bound);
+			acb_ode_plan_clear(plan);
+		}
+		actual_tail(tail, ref, n + 1, eta);
+		if (n >= 200 || !mag_is_finite(err) || mag_cmp(tail, err) > 0)
+			return_value = EXIT_FAILURE | 0x4;
+
+		acb_ode_solution_clear(sol);
+		acb_ode_solution_clear(ref);
+		acb_ode_clear(ODE);
+		if (return_value != EXIT_SUCCESS)
+			break;
+	}
+
+	mag_clear(eta);
+	mag_clear(err);
+	mag_clear(tail);
+	mag_clear(derivs);
+	mag_clear(derivs + 1);
+	arb_clear(dist);
+	arb_clear(rad);
+	acb_clear(a);
+	acb_clear(nu);
+	acb_clear(nu2);
+	flint_randclear(state);
+	flint_cleanup();
+	return return_value;
+}
@@ -0,0 +1,106 @@
+#include "cascade.h"
+#include <acb_mat.h>
+
+int main ()
+{
+	int return_value = EXIT_SUCCESS;
+
+	slong prec, steps;
+
+	flint_rand_t state;
+
+	acb_t x, c, s;
+	acb_ptr corners;
+	acb_poly_t res;
+	acb_mat_t T, expected;
+	acb_ode_t ODE;
+	acb_ode_path_t path;
+
+	flint_randinit(state);
+	acb_init(x);
+	acb_init(c);
+	acb_init(s);
+	corners = _acb_vec_init(2);
+	acb_poly_init(res);
+	acb_mat_init(T, 2, 2);
+	acb_mat_init(expected, 2, 2);
+	acb_ode_path_init(path);
+
+	for (slong iter = 0; iter < 10; iter++)
+	{
+		prec = 30 + n_randint(state, 128);
+		flint_set_num_threads(1 + n_randint(state, 4));
+
+		/* For y'' = -y, the transition matrix is a rotation */
+		acb_ode_init_blank(ODE, 0, 2);
+		acb_one(acb_ode_coeff(ODE, 2, 0));
+		acb_one(acb_ode_coeff(ODE, 0, 0));
+
+		acb_set_si_si(x, n_randint(state, 17) - 8, n_randint(state, 9) - 4);
+		acb_mul_2exp_si(x, x, -2);
+		steps = 1 + n_randint(state, 16);
+		path->length = 0;
+		for (slong k = 0; k <= steps; k++)
+		{
+			acb_mul_si(c, x, k, prec);
+			acb_div_si(c, c, steps, prec);
+			acb_ode_path_append(path, c, 20 + prec/2);
+		}
+
+		acb_ode_path_transition_matrix(T, ODE, path, prec);
+		acb_sin_cos(s, c, x, prec);
+		acb_set(acb_mat_entry(expected, 0, 0), c);
+		acb_set(acb_mat_entry(expected, 0, 1), s);
+		acb_neg(acb_mat_entry(expected, 1, 0), s);
+		acb_set(acb_mat_entry(expected, 1, 1), c);
+		if (!acb_mat_overlaps(T, expected))
+			return_value = EXIT_FAILURE | 0x2;
+		acb_ode_clear(ODE);
+		if (return_value != EXIT_SUCCESS)
+			break;
+		if (iter % 2)
+			continue;
+
+		/* Compare to the serial continuation, both enclosing the truncation error */
+		acb_ode_legendre(ODE, 1 + n_randint(state, 10));
+		acb_zero(corners);
+		acb_set_d_d(corners + 1, 0.75, 0.5);
+		acb_ode_path_adaptive(path, ODE, corners, 2, prec);
+		acb_ode_path_transition_matrix(T, ODE, path, prec);
+
+		/* A path built for few bits has too few terms, the tail bound makes up for them */
+		acb_ode_path_adaptive(path, ODE, corners, 2, 8);
+		acb_ode_path_transition_matrix(expected, ODE, path, prec);
+		if (!acb_mat_overlaps(T, expected))
+			return_value = EXIT_FAILURE | 0x4;
+
+		flint_set_num_threads(1);
+		for (slong i = 0; i < order(ODE); i++)
+		{
+			acb_poly_zero(res);
+			acb_poly_set_coeff_si(res, i, 1);
+			analytic_continuation_path(res, ODE, path, prec);
+			for (slong j = 0; j < order(ODE); j++)
+			{
+				acb_poly_get_coeff_acb(c, res, j);
+				if (!acb_overlaps(c, acb_mat_entry(T, j, i)))
+					return_value = EXIT_FAILURE | 0x4;
+			}
+		}
+		acb_ode_clear(ODE);
+		if (return_value != EXIT_SUCCESS)
+			break;
+	}
+
+	acb_ode_path_clear(path);
+	acb_mat_clear(T);
+	acb_mat_clear(expected);
+	acb_poly_clear(res);
+	_acb_vec_clear(corners, 2);
+	acb_clear(x);
+	acb_clear(c);
+	acb_clear(s);
+	flint_randclear(state);
+	flint_cleanup();
+	return return_value;
+}
@@ -0,0 +1,191 @@
+#include "cascade.h"
+
+/* The polynomial solution of Legendre's equation, by the recurrence of its coefficients */
+static void legendre_series (acb_poly_t res, ulong m, slong deg, slong prec)
+{
+	acb_t c;
+	acb_init(c);
+
+	acb_poly_zero(res);
+	acb_poly_set_coeff_si(res, m % 2, 1);
+	for (slong k = m % 2; k + 2 <= deg; k += 2)
+	{
+		acb_poly_get_coeff_acb(c, res, k);
+		acb_mul_si(c, c, k*(k+1) - (slong) (m*(m+1)), prec);
+		acb_div_si(c, c, (k+1)*(k+2), prec);
+		acb_poly_set_coeff_acb(res, k + 2, c);
+	}
+	acb_clear(c);
+}
+
+/* The coefficients c_{2k} = c_0 (-1)^k / (4^k k! (nu+1)_k) of Bessel's equation */
+static int bessel_series_overlaps (const acb_poly_t g, const acb_t nu, slong prec)
+{
+	int ok;
+	acb_t c, t;
+	acb_init(c);
+	acb_init(t);
+
+	acb_poly_get_coeff_acb(c, g, 0);
+	ok = !acb_contains_zero(c);
+	for (slong n = 1; n < acb_poly_length(g) && ok; n++)
+	{
+		acb_poly_get_coeff_acb(t, g, n);
+		if (n % 2)
+		{
+			ok = acb_contains_zero(t);
+			continue;
+		}
+		acb_add_si(c, nu, n/2, prec);
+		acb_mul_si(c, c, -2*n, prec);
+		acb_poly_get_coeff_acb(t, g, n - 2);
+		acb_div(c, t, c, prec);
+		acb_poly_get_coeff_acb(t, g, n);
+		ok = acb_overlaps(c, t);
+	}
+
+	acb_clear(c);
+	acb_clear(t);
+	return ok;
+}
+
+int main ()
+{
+	int return_value = EXIT_SUCCESS;
+
+	slong prec, n, len;
+	ulong m;
+
+	flint_rand_t state;
+
+	acb_ptr path;
+	acb_t nu, nu2;
+	mag_t eta, err, res;
+	acb_poly_t in, out, expected, temp;
+	acb_ode_t ODE;
+	acb_ode_solution_t sol;
+	acb_ode_workspace_t ws;
+
+	flint_randinit(state);
+	path = _acb_vec_init(4);
+	acb_init(nu);
+	acb_init(nu2);
+	mag_init(eta);
+	mag_init(err);
+	mag_init(res);
+	acb_poly_init(in);
+	acb_poly_init(out);
+	acb_poly_init(expected);
+	acb_poly_init(temp);
+
+	/* A single workspace is reused for operators of all sizes */
+	acb_ode_workspace_init(ws);
+	for (slong iter = 0; iter < 100; iter++)
+	{
+		prec = 30 + n_randint(state, 128);
+		n = 1 + n_randint(state, 60);
+
+		/* Differential action against the sum of P_i times the i-th derivative */
+		acb_ode_random(ODE, state, prec);
+		acb_poly_randtest(in, state, n_randint(state, 40), prec, 8);
+		len = n_randint(state, 50);
+		acb_poly_zero(expected);
+		acb_poly_set(out, in);
+		for (slong i = 0; i <= order(ODE); i++)
+		{
+			acb_poly_fit_length(temp, degree(ODE) + 1);
+			_acb_vec_set(temp->coeffs, acb_ode_poly(ODE, i), degree(ODE) + 1);
+			_acb_poly_set_length(temp, degree(ODE) + 1);
+			_acb_poly_normalise(temp);
+			acb_poly_mul(temp, temp, out, prec);
+			acb_poly_add(expected, expected, temp, prec);
+			acb_poly_derivative(out, out, prec);
+		}
+		acb_poly_set(temp, expected);
+		acb_poly_truncate(expected, len);
+		acb_poly_set(out, in);
+		acb_ode_apply_trunc_ws(out, ODE, out, len, ws, prec);
+		if (!acb_poly_overlaps(out, expected))
+			return_value = EXIT_FAILURE | 0x2;
+		acb_ode_apply_ws(out, ODE, in, ws, prec);
+		if (!acb_poly_overlaps(out, temp))
+			return_value = EXIT_FAILURE | 0x2;
+		acb_ode_clear(ODE);
+
+		/* Power series solutions against the polynomial solution of Legendre's equation */
+		m = n_randint(state, 10);
+		acb_ode_legendre(ODE, m);
+		acb_poly_zero(out);
+		acb_poly_set_coeff_si(out, m % 2, 1);
+		acb_ode_solve_fuchs_ws(out, ODE, n, ws, prec);
+		legendre_series(expected, m, n, prec);
+		if (!acb_poly_overlaps(out, expected))
+			return_value = EXIT_FAILURE | 0x4;
+
+		acb_ode_residual_ws(res, ODE, out, n - 2, ws, prec);
+		if (mag_cmp_2exp_si(res, -20) > 0)
+			return_value = EXIT_FAILURE | 0x4;
+
+		mag_set_ui_2exp_si(eta, 1, -1 - n_randint(state, 4));
+		acb_poly_zero(out);
+		acb_poly_set_coeff_si(out, m % 2, 1);
+		len = acb_ode_solve_fuchs_tail_ws(out, err, ODE, eta, n, ws, prec);
+		legendre_series(expected, m, len, prec);
+		if (len > n || !acb_poly_overlaps(out, expected))
+			return_value = EXIT_FAILURE | 0x4;
+
+		/* Analytic continuation of the polynomial solution from the origin */
+		acb_zero(path);
+		for (slong k = 1; k < 4; k++)
+		{
+			acb_set_si(path + k, n_randint(state, 9) - 4);
+			acb_div_si(path + k, path + k, 16, prec);
+		}
+		acb_poly_zero(out);
+		acb_poly_set_coeff_si(out, m % 2, 1);
+		analytic_continuation_ws(out, ODE, path, 4, FLINT_MAX(n, 10), ws, prec);
+		legendre_series(expected, m, m, prec);
+		acb_poly_taylor_shift(expected, expected, path + 3, prec);
+		if (!acb_poly_overlaps(out, expected))
+			return_value = EXIT_FAILURE | 0x8;
+		acb_ode_clear(ODE);
+
+		/* Frobenius' method, with and without logarithms */
+		slong mul = 1 + n_randint(state, 2);
+		acb_set_si(nu, (mul == 1) ? n_randint(state, 32) : 0);
+		acb_div_si(nu, nu, 1 << n_randint(state, 4), prec);
+		acb_set(nu2, nu);
+		acb_ode_bessel(ODE, nu2, prec);
+
+		acb_ode_solution_init(sol, nu, mul, 0);
+		acb_ode_solve_frobenius_ws(sol, ODE, n, ws, prec);
+		if (!bessel_series_overlaps(sol->gens, nu, prec))
+			return_value = EXIT_FAILURE | 0x10;
+		acb_ode_solution_clear(sol);
+
+		acb_ode_solution_init(sol, nu, mul, 0);
+		len = acb_ode_solve_frobenius_tail_ws(sol, err, ODE, eta, n, ws, prec);
+		if (len > n || !bessel_series_overlaps(sol->gens, nu, prec))
+			return_value = EXIT_FAILURE | 0x10;
+		acb_ode_solution_clear(sol);
+		acb_ode_clear(ODE);
+
+		if (return_value != EXIT_SUCCESS)
+			break;
+	}
+	acb_ode_workspace_clear(ws);
+
+	_acb_vec_clear(path, 4);
+	acb_clear(nu);
+	acb_clear(nu2);
+	mag_clear(eta);
+	mag_clear(err);
+	mag_clear(res);
+	acb_poly_clear(in);
+	acb_poly_clear(out);
+	acb_poly_clear(expected);
+	acb_poly_clear(temp);
+	flint_randclear(state);
+	flint_cleanup();
+	return return_value;
+}